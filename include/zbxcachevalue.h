@@ -78,6 +78,23 @@ typedef struct
 }
 zbx_vc_stats_t;
 
+#define ZBX_VC_WARMUP_STATE_NONE	0
+#define ZBX_VC_WARMUP_STATE_RUNNING	1
+#define ZBX_VC_WARMUP_STATE_FINISHED	2
+#define ZBX_VC_WARMUP_STATE_STOPPED	3
+
+/* the warm-up progress, summed over all history syncers */
+typedef struct
+{
+	zbx_uint64_t	items_num;
+	zbx_uint64_t	processed_num;
+	zbx_uint64_t	cached_num;
+
+	/* see ZBX_VC_WARMUP_STATE_* defines */
+	int		state;
+}
+zbx_vc_warmup_stats_t;
+
 /* item diagnostic statistics */
 typedef struct
 {
@@ -115,9 +132,15 @@ void	zbx_vc_remove_items_by_ids(zbx_vector_uint64_t *itemids);
 
 void	zbx_vc_get_diag_stats(zbx_uint64_t *items_num, zbx_uint64_t *values_num, int *mode);
 void	zbx_vc_get_mem_stats(zbx_shmem_stats_t *mem);
+void	zbx_vc_get_warmup_stats(zbx_vc_warmup_stats_t *stats);
 void	zbx_vc_get_item_stats(zbx_vector_vc_item_stats_ptr_t *stats);
 void	zbx_vc_flush_stats(void);
 
+void	zbx_vc_warm_up(zbx_vector_uint64_pair_t *items);
+
 void	zbx_vc_add_new_items(const zbx_vector_uint64_pair_t *items);
 
+int	zbx_vc_save_snapshot(const char *filename, char **error);
+int	zbx_vc_load_snapshot(const char *filename, char **error);
+
 #endif
@@ -49,6 +49,7 @@ int	zbx_parse_redirect_response(struct zbx_json_parse *jp, char **host, unsigned
 
 int	zbx_comms_exchange_with_redirect(const char *source_ip, zbx_vector_addr_ptr_t *addrs, int timeout,
 		int connect_timeout, int retry_interval, int loglevel, const zbx_config_tls_t *config_tls,
-		const char *data, char *(*connect_callback)(void *), void *cb_data, char **out, char **error);
+		const char *data, unsigned char flags, char *(*connect_callback)(void *), void *cb_data, char **out,
+		char **error);
 
 #endif // ZABBIX_COMMSHIGH_H
@@ -29,6 +29,16 @@ zbx_history_record_t;
 
 ZBX_VECTOR_DECL(history_record, zbx_history_record_t)
 
+/* the item history value with its itemid, used in multiple item requests */
+typedef struct
+{
+	zbx_uint64_t		itemid;
+	zbx_history_record_t	record;
+}
+zbx_history_item_record_t;
+
+ZBX_VECTOR_DECL(history_item_record, zbx_history_item_record_t)
+
 int	zbx_history_record_float_compare(const zbx_history_record_t *d1, const zbx_history_record_t *d2);
 
 void	zbx_history_record_vector_clean(zbx_vector_history_record_t *vector, int value_type);
@@ -73,6 +83,9 @@ int	zbx_history_add_values(const zbx_vector_dc_history_ptr_t *history, int *ret_
 		int config_history_storage_pipelines);
 int	zbx_history_get_values(zbx_uint64_t itemid, int value_type, int start, int count, int end,
 		zbx_vector_history_record_t *values);
+int	zbx_history_get_items_values(const zbx_uint64_t *itemids, int itemids_num, int value_type, int start, int end,
+		zbx_vector_history_item_record_t *values);
+void	zbx_history_item_record_vector_destroy(zbx_vector_history_item_record_t *vector, int value_type);
 
 int	zbx_history_requires_trends(int value_type);
 void	zbx_history_check_version(struct zbx_json *json, int *result, int config_allow_unsupported_db_versions,
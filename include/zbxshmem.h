@@ -40,6 +40,9 @@ typedef struct
 	/* Set this flag to 1 to allow execution in out of memory situations.     */
 	char		allow_oom;
 
+	/* 1 if the segment is backed by huge pages */
+	char		huge_pages;
+
 	const char	*mem_descr;
 	const char	*mem_param;
 }
@@ -55,9 +58,12 @@ typedef struct
 	unsigned int	chunks_num[ZBX_SHMEM_BUCKET_COUNT];
 	unsigned int	free_chunks;
 	unsigned int	used_chunks;
+	unsigned char	huge_pages;
 }
 zbx_shmem_stats_t;
 
+void	zbx_shmem_set_huge_pages(int huge_pages);
+
 int	zbx_shmem_create(zbx_shmem_info_t **info, zbx_uint64_t size, const char *descr, const char *param,
 		int allow_oom, char **error);
 int	zbx_shmem_create_min(zbx_shmem_info_t **info, zbx_uint64_t size, const char *descr, const char *param,
@@ -15,7 +15,7 @@
 #include "zbxalgo.h"
 
 
-static void	swap(zbx_binary_heap_t *heap, int index_1, int index_2);
+static void	__binary_heap_move(zbx_binary_heap_t *heap, int index_to, int index_from);
 
 static void	__binary_heap_ensure_free_space(zbx_binary_heap_t *heap);
 
@@ -28,19 +28,12 @@ static int	__binary_heap_bubble_down(zbx_binary_heap_t *heap, int index);
 
 /* helper functions */
 
-static void	swap(zbx_binary_heap_t *heap, int index_1, int index_2)
+static void	__binary_heap_move(zbx_binary_heap_t *heap, int index_to, int index_from)
 {
-	zbx_binary_heap_elem_t	tmp;
-
-	tmp = heap->elems[index_1];
-	heap->elems[index_1] = heap->elems[index_2];
-	heap->elems[index_2] = tmp;
+	heap->elems[index_to] = heap->elems[index_from];
 
 	if (HAS_DIRECT_OPTION(heap))
-	{
-		zbx_hashmap_set(heap->key_index, heap->elems[index_1].key, index_1);
-		zbx_hashmap_set(heap->key_index, heap->elems[index_2].key, index_2);
-	}
+		zbx_hashmap_set(heap->key_index, heap->elems[index_to].key, index_to);
 }
 
 /* private binary heap functions */
@@ -76,15 +69,32 @@ static void	__binary_heap_ensure_free_space(zbx_binary_heap_t *heap)
 	}
 }
 
+/* The element being sifted is kept aside and the elements it passes are moved into the hole left  */
+/* behind instead of swapping, so only the moved elements and the final position are written and   */
+/* updated in the key index.                                                                       */
+
 static int	__binary_heap_bubble_up(zbx_binary_heap_t *heap, int index)
 {
+	zbx_binary_heap_elem_t	elem = heap->elems[index];
+	int			start = index;
+
 	while (0 != index)
 	{
-		if (heap->compare_func(&heap->elems[(index - 1) / 2], &heap->elems[index]) <= 0)
+		int	parent = (index - 1) / 2;
+
+		if (heap->compare_func(&heap->elems[parent], &elem) <= 0)
 			break;
 
-		swap(heap, (index - 1) / 2, index);
-		index = (index - 1) / 2;
+		__binary_heap_move(heap, index, parent);
+		index = parent;
+	}
+
+	if (index != start)
+	{
+		heap->elems[index] = elem;
+
+		if (HAS_DIRECT_OPTION(heap))
+			zbx_hashmap_set(heap->key_index, elem.key, index);
 	}
 
 	return index;
@@ -92,45 +102,33 @@ static int	__binary_heap_bubble_up(zbx_binary_heap_t *heap, int index)
 
 static int	__binary_heap_bubble_down(zbx_binary_heap_t *heap, int index)
 {
+	zbx_binary_heap_elem_t	elem = heap->elems[index];
+	int			start = index;
+
 	while (1)
 	{
-		int left = 2 * index + 1;
-		int right = 2 * index + 2;
+		int	child = 2 * index + 1;
+		int	right = 2 * index + 2;
 
-		if (left >= heap->elems_num)
+		if (child >= heap->elems_num)
 			break;
 
-		if (right >= heap->elems_num)
-		{
-			if (heap->compare_func(&heap->elems[index], &heap->elems[left]) > 0)
-			{
-				swap(heap, index, left);
-				index = left;
-			}
+		if (right < heap->elems_num && heap->compare_func(&heap->elems[child], &heap->elems[right]) > 0)
+			child = right;
 
+		if (heap->compare_func(&elem, &heap->elems[child]) <= 0)
 			break;
-		}
 
-		if (heap->compare_func(&heap->elems[left], &heap->elems[right]) <= 0)
-		{
-			if (heap->compare_func(&heap->elems[index], &heap->elems[left]) > 0)
-			{
-				swap(heap, index, left);
-				index = left;
-			}
-			else
-				break;
-		}
-		else
-		{
-			if (heap->compare_func(&heap->elems[index], &heap->elems[right]) > 0)
-			{
-				swap(heap, index, right);
-				index = right;
-			}
-			else
-				break;
-		}
+		__binary_heap_move(heap, index, child);
+		index = child;
+	}
+
+	if (index != start)
+	{
+		heap->elems[index] = elem;
+
+		if (HAS_DIRECT_OPTION(heap))
+			zbx_hashmap_set(heap->key_index, elem.key, index);
 	}
 
 	return index;
@@ -906,8 +906,10 @@ void	dc_strpool_release(const char *str)
 	zbx_uint32_t	*refcount;
 
 	refcount = (zbx_uint32_t *)(str - REFCOUNT_FIELD_SIZE);
+
+	/* the record is the hashset entry data, remove it by the stored hash without rehashing the string */
 	if (0 == --(*refcount))
-		zbx_hashset_remove(&config->strpool, str - REFCOUNT_FIELD_SIZE);
+		zbx_hashset_remove_direct(&config->strpool, (void *)refcount);
 }
 
 const char	*dc_strpool_acquire(const char *str)
@@ -4006,9 +4008,18 @@ static void	DCsync_template_items(zbx_dbsync_t *sync)
 	unsigned char		tag;
 	int			ret, found;
 	ZBX_DC_TEMPLATE_ITEM	*item;
+	zbx_hashset_uniq_t	uniq = ZBX_HASHSET_UNIQ_FALSE;
 
 	zabbix_log(LOG_LEVEL_DEBUG, "In %s()", __func__);
 
+	if (0 == config->template_items.num_slots)
+	{
+		int	row_num = zbx_dbsync_get_row_num(sync);
+
+		zbx_hashset_reserve(&config->template_items, MAX(row_num, 100));
+		uniq = ZBX_HASHSET_UNIQ_TRUE;
+	}
+
 	while (SUCCEED == (ret = zbx_dbsync_next(sync, &rowid, &row, &tag)))
 	{
 		/* removed rows will be always added at the end */
@@ -4016,8 +4027,8 @@ static void	DCsync_template_items(zbx_dbsync_t *sync)
 			break;
 
 		ZBX_STR2UINT64(itemid, row[0]);
-		item = (ZBX_DC_TEMPLATE_ITEM *)DCfind_id(&config->template_items, itemid, sizeof(ZBX_DC_TEMPLATE_ITEM),
-				&found);
+		item = (ZBX_DC_TEMPLATE_ITEM *)DCfind_id_ext(&config->template_items, itemid,
+				sizeof(ZBX_DC_TEMPLATE_ITEM), &found, uniq);
 
 		ZBX_STR2UINT64(item->hostid, row[1]);
 		ZBX_DBROW2UINT64(item->templateid, row[2]);
@@ -4042,9 +4053,18 @@ static void	DCsync_prototype_items(zbx_dbsync_t *sync)
 	unsigned char		tag;
 	int			ret, found;
 	ZBX_DC_PROTOTYPE_ITEM	*item;
+	zbx_hashset_uniq_t	uniq = ZBX_HASHSET_UNIQ_FALSE;
 
 	zabbix_log(LOG_LEVEL_DEBUG, "In %s()", __func__);
 
+	if (0 == config->prototype_items.num_slots)
+	{
+		int	row_num = zbx_dbsync_get_row_num(sync);
+
+		zbx_hashset_reserve(&config->prototype_items, MAX(row_num, 100));
+		uniq = ZBX_HASHSET_UNIQ_TRUE;
+	}
+
 	while (SUCCEED == (ret = zbx_dbsync_next(sync, &rowid, &row, &tag)))
 	{
 		/* removed rows will be always added at the end */
@@ -4052,8 +4072,8 @@ static void	DCsync_prototype_items(zbx_dbsync_t *sync)
 			break;
 
 		ZBX_STR2UINT64(itemid, row[0]);
-		item = (ZBX_DC_PROTOTYPE_ITEM *)DCfind_id(&config->prototype_items, itemid,
-				sizeof(ZBX_DC_PROTOTYPE_ITEM), &found);
+		item = (ZBX_DC_PROTOTYPE_ITEM *)DCfind_id_ext(&config->prototype_items, itemid,
+				sizeof(ZBX_DC_PROTOTYPE_ITEM), &found, uniq);
 
 		ZBX_STR2UINT64(item->hostid, row[1]);
 		ZBX_DBROW2UINT64(item->templateid, row[2]);
@@ -5622,9 +5642,18 @@ static void	DCsync_trigger_tags(zbx_dbsync_t *sync)
 	zbx_uint64_t		triggerid, triggertagid;
 	ZBX_DC_TRIGGER		*trigger;
 	zbx_dc_trigger_tag_t	*trigger_tag;
+	zbx_hashset_uniq_t	uniq = ZBX_HASHSET_UNIQ_FALSE;
 
 	zabbix_log(LOG_LEVEL_DEBUG, "In %s()", __func__);
 
+	if (0 == config->trigger_tags.num_slots)
+	{
+		int	row_num = zbx_dbsync_get_row_num(sync);
+
+		zbx_hashset_reserve(&config->trigger_tags, MAX(row_num, 100));
+		uniq = ZBX_HASHSET_UNIQ_TRUE;
+	}
+
 	while (SUCCEED == (ret = zbx_dbsync_next(sync, &rowid, &row, &tag)))
 	{
 		/* removed rows will be always added at the end */
@@ -5638,8 +5667,8 @@ static void	DCsync_trigger_tags(zbx_dbsync_t *sync)
 
 		ZBX_STR2UINT64(triggertagid, row[0]);
 
-		trigger_tag = (zbx_dc_trigger_tag_t *)DCfind_id(&config->trigger_tags, triggertagid,
-				sizeof(zbx_dc_trigger_tag_t), &found);
+		trigger_tag = (zbx_dc_trigger_tag_t *)DCfind_id_ext(&config->trigger_tags, triggertagid,
+				sizeof(zbx_dc_trigger_tag_t), &found, uniq);
 		dc_strpool_replace(found, &trigger_tag->tag, row[2]);
 		dc_strpool_replace(found, &trigger_tag->value, row[3]);
 
@@ -6074,11 +6103,20 @@ static void	DCsync_items_param(zbx_dbsync_t *sync, zbx_uint64_t revision)
 	int			found, ret, i, index;
 	zbx_dc_item_param_t	*item_param;
 	zbx_vector_ptr_t	items;
+	zbx_hashset_uniq_t	uniq = ZBX_HASHSET_UNIQ_FALSE;
 
 	zabbix_log(LOG_LEVEL_DEBUG, "In %s()", __func__);
 
 	zbx_vector_ptr_create(&items);
 
+	if (0 == config->items_params.num_slots)
+	{
+		int	row_num = zbx_dbsync_get_row_num(sync);
+
+		zbx_hashset_reserve(&config->items_params, MAX(row_num, 100));
+		uniq = ZBX_HASHSET_UNIQ_TRUE;
+	}
+
 	while (SUCCEED == (ret = zbx_dbsync_next(sync, &rowid, &row, &tag)))
 	{
 		zbx_vector_ptr_t	*params;
@@ -6099,8 +6137,8 @@ static void	DCsync_items_param(zbx_dbsync_t *sync, zbx_uint64_t revision)
 		}
 
 		ZBX_STR2UINT64(item_paramid, row[0]);
-		item_param = (zbx_dc_item_param_t *)DCfind_id(&config->items_params, item_paramid,
-				sizeof(zbx_dc_item_param_t), &found);
+		item_param = (zbx_dc_item_param_t *)DCfind_id_ext(&config->items_params, item_paramid,
+				sizeof(zbx_dc_item_param_t), &found, uniq);
 
 		dc_strpool_replace(found, &item_param->name, row[2]);
 		dc_strpool_replace(found, &item_param->value, row[3]);
@@ -7839,6 +7877,13 @@ zbx_uint64_t	zbx_dc_sync_configuration(unsigned char mode, zbx_synced_new_config
 	/* applying changelog diff. To detect this problem configuration is synced */
 	/* in transaction and error is checked at the end.                         */
 	zbx_db_begin();
+#elif defined(HAVE_SQLITE3)
+	/* With SQLite every select locks and unlocks database access mutex and     */
+	/* reads from its own snapshot. Initial sync reads all configuration tables */
+	/* at once, so do it in single transaction to keep the database locked     */
+	/* only once and to get consistent data across the tables.                  */
+	if (ZBX_DBSYNC_INIT == mode)
+		zbx_db_begin();
 #endif
 
 	sec = zbx_time();
@@ -8631,11 +8676,14 @@ out:
 
 	FINISH_SYNC;
 
-#ifdef HAVE_ORACLE
-	if (ZBX_DB_OK == dberr)
-		dberr = zbx_db_commit();
-	else
-		zbx_db_rollback();
+#if defined(HAVE_ORACLE) || defined(HAVE_SQLITE3)
+	if (0 != zbx_db_txn_level())
+	{
+		if (ZBX_DB_OK == dberr)
+			dberr = zbx_db_commit();
+		else
+			zbx_db_rollback();
+	}
 #endif
 	switch (dberr)
 	{
@@ -8691,6 +8739,11 @@ out:
 				" please check \"StartConnectors\" configuration parameter");
 	}
 clean:
+#if defined(HAVE_ORACLE) || defined(HAVE_SQLITE3)
+	/* configuration sync was postponed, close the transaction */
+	if (0 != zbx_db_txn_level())
+		zbx_db_rollback();
+#endif
 	zbx_dbsync_clear(&config_sync);
 	zbx_dbsync_clear(&autoreg_config_sync);
 	zbx_dbsync_clear(&autoreg_host_sync);
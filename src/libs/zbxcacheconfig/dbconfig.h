@@ -266,39 +266,43 @@ ZBX_DC_ITEMVALUETYPE;
 
 typedef struct
 {
+	/* fields used by poller queue scheduling are grouped together at the        */
+	/* beginning of the structure, within its first 64 bytes, so that queue      */
+	/* operations touch few cache lines                                          */
 	zbx_uint64_t		itemid;
 	zbx_uint64_t		hostid;
 	zbx_uint64_t		interfaceid;
+	ZBX_DC_ITEMTYPE		itemtype;
+	const char		*delay;
+	int			nextcheck;
+	unsigned char		type;
+	unsigned char		poller_type;
+	unsigned char		state;
+	unsigned char		status;
+	unsigned char		location;
+	unsigned char		queue_priority;
+
 	zbx_uint64_t		lastlogsize;
 	zbx_uint64_t		valuemapid;
 	const char		*key;
 	const char		*port;
 	const char		*error;
-	const char		*delay;
 	const char		*delay_ex;
 	const char		*history_period;
 	const char		*timeout;
 	ZBX_DC_TRIGGER		**triggers;
-	ZBX_DC_ITEMTYPE		itemtype;
 	ZBX_DC_ITEMVALUETYPE	itemvaluetype;
 	zbx_uint64_t		revision;
 	zbx_uint64_t		templateid;
 	ZBX_DC_PREPROCITEM	*preproc_item;
 	ZBX_DC_MASTERITEM	*master_item;
 	zbx_vector_ptr_t	tags;
-	int			nextcheck;
 	int			mtime;
 	int			data_expected_from;
-	unsigned char		type;
 	unsigned char		value_type;
-	unsigned char		poller_type;
-	unsigned char		state;
 	unsigned char		db_state;
 	unsigned char		inventory_link;
-	unsigned char		location;
 	unsigned char		flags;
-	unsigned char		status;
-	unsigned char		queue_priority;
 	unsigned char		update_triggers;
 }
 ZBX_DC_ITEM;
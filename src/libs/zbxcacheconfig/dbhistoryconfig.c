@@ -245,6 +245,48 @@ int	zbx_dc_config_history_get_trends_sec(const char *trends_period, int trends_g
 	return trends_sec;
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: get enabled items used in triggers                                *
+ *                                                                            *
+ * Parameters: items         - [OUT] itemid, value type pairs                 *
+ *             process_num   - [IN] history syncer process number             *
+ *             process_forks - [IN] number of history syncer processes        *
+ *                                                                            *
+ * Comments: Items are distributed between history syncers by itemid so each  *
+ *           item is returned to one history syncer only.                     *
+ *                                                                            *
+ ******************************************************************************/
+void	zbx_dc_config_history_sync_get_trigger_items(zbx_vector_uint64_pair_t *items, int process_num,
+		int process_forks)
+{
+	zbx_hashset_iter_t	iter;
+	const ZBX_DC_ITEM	*dc_item;
+
+	RDLOCK_CACHE_CONFIG_HISTORY;
+
+	zbx_vector_uint64_pair_reserve(items, (size_t)(get_dc_config()->items.num_data / MAX(process_forks, 1)));
+
+	zbx_hashset_iter_reset(&(get_dc_config())->items, &iter);
+
+	while (NULL != (dc_item = (const ZBX_DC_ITEM *)zbx_hashset_iter_next(&iter)))
+	{
+		zbx_uint64_pair_t	pair;
+
+		if (NULL == dc_item->triggers || ITEM_STATUS_ACTIVE != dc_item->status)
+			continue;
+
+		if (1 < process_forks && (int)(dc_item->itemid % (zbx_uint64_t)process_forks) != process_num - 1)
+			continue;
+
+		pair.first = dc_item->itemid;
+		pair.second = dc_item->value_type;
+		zbx_vector_uint64_pair_append_ptr(items, &pair);
+	}
+
+	UNLOCK_CACHE_CONFIG_HISTORY;
+}
+
 void	zbx_dc_config_history_sync_unset_existing_itemids(zbx_vector_uint64_t *itemids)
 {
 	int	i;
@@ -374,6 +374,46 @@ void	zbx_dc_update_trends(zbx_vector_uint64_pair_t *trends_diff)
 	zabbix_log(LOG_LEVEL_DEBUG, "End of %s()", __func__);
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: find trend in array sorted by itemid, clock                       *
+ *                                                                            *
+ * Parameters: trends     - [IN] trends sorted with zbx_trend_compare()       *
+ *             trends_num - [IN] number of trends                             *
+ *             itemid     - [IN]                                              *
+ *             clock      - [IN]                                              *
+ *             value_type - [IN]                                              *
+ *                                                                            *
+ * Return value: pointer to the trend or NULL if not found                    *
+ *                                                                            *
+ ******************************************************************************/
+static ZBX_DC_TREND	*dc_trends_search(ZBX_DC_TREND *trends, int trends_num, zbx_uint64_t itemid, int clock,
+		unsigned char value_type)
+{
+	ZBX_DC_TREND	trend_local, *trend, *end = trends + trends_num;
+
+	trend_local.itemid = itemid;
+	trend_local.clock = clock;
+
+	if (NULL == (trend = (ZBX_DC_TREND *)bsearch(&trend_local, trends, (size_t)trends_num,
+			sizeof(ZBX_DC_TREND), zbx_trend_compare)))
+	{
+		return NULL;
+	}
+
+	/* the same item hour can be present for different value types when item value type was changed */
+	while (trend > trends && 0 == zbx_trend_compare(trend - 1, &trend_local))
+		trend--;
+
+	for (; trend < end && 0 == zbx_trend_compare(trend, &trend_local); trend++)
+	{
+		if (value_type == trend->value_type)
+			return trend;
+	}
+
+	return NULL;
+}
+
 /******************************************************************************
  *                                                                            *
  * Purpose: helper function for DCflush trends                                *
@@ -433,7 +473,7 @@ static void	dc_insert_trends_in_db(ZBX_DC_TREND *trends, int trends_num, unsigne
 static void	dc_remove_updated_trends(ZBX_DC_TREND *trends, int trends_num, const char *table_name,
 		int value_type, zbx_uint64_t *itemids, int *itemids_num, int clock)
 {
-	int		i, j, clocks_num, now, age;
+	int		j, clocks_num, now, age;
 	ZBX_DC_TREND	*trend;
 	zbx_uint64_t	itemid;
 	size_t		sql_offset;
@@ -477,19 +517,8 @@ static void	dc_remove_updated_trends(ZBX_DC_TREND *trends, int trends_num, const
 	{
 		itemid = itemids[--*itemids_num];
 
-		for (i = 0; i < trends_num; i++)
-		{
-			trend = &trends[i];
-
-			if (itemid != trend->itemid)
-				continue;
-
-			if (clock != trend->clock || value_type != trend->value_type)
-				continue;
-
+		if (NULL != (trend = dc_trends_search(trends, trends_num, itemid, clock, (unsigned char)value_type)))
 			trend->disable_from = clock;
-			break;
-		}
 	}
 }
 
@@ -571,14 +600,15 @@ static void	dc_trends_fetch_and_update(ZBX_DC_TREND *trends, int trends_num, zbx
 		int itemids_num, int *inserts_num, unsigned char value_type,
 		const char *table_name, int clock)
 {
-
-	int		i, num;
+	int		i, num, updated_num = 0;
 	zbx_db_result_t	result;
 	zbx_db_row_t	row;
 	zbx_uint64_t	itemid;
-	ZBX_DC_TREND	*trend;
+	ZBX_DC_TREND	*trend, **updated;
 	size_t		sql_offset;
 
+	updated = (ZBX_DC_TREND **)zbx_malloc(NULL, (size_t)itemids_num * sizeof(ZBX_DC_TREND *));
+
 	sql_offset = 0;
 	zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset,
 			"select itemid,num,value_min,value_avg,value_max"
@@ -597,20 +627,8 @@ static void	dc_trends_fetch_and_update(ZBX_DC_TREND *trends, int trends_num, zbx
 	{
 		ZBX_STR2UINT64(itemid, row[0]);
 
-		for (i = 0; i < trends_num; i++)
-		{
-			trend = &trends[i];
-
-			if (itemid != trend->itemid)
-				continue;
-
-			if (clock != trend->clock || value_type != trend->value_type)
-				continue;
-
-			break;
-		}
-
-		if (i == trends_num)
+		if (NULL == (trend = dc_trends_search(trends, trends_num, itemid, clock, value_type)) ||
+				updated_num == itemids_num)
 		{
 			THIS_SHOULD_NEVER_HAPPEN;
 			continue;
@@ -623,7 +641,8 @@ static void	dc_trends_fetch_and_update(ZBX_DC_TREND *trends, int trends_num, zbx
 		else
 			dc_trends_update_uint(trend, row, num, &sql_offset);
 
-		trend->itemid = 0;
+		/* trends are marked as flushed only after all rows are processed to keep the array sorted */
+		updated[updated_num++] = trend;
 
 		--*inserts_num;
 
@@ -632,6 +651,11 @@ static void	dc_trends_fetch_and_update(ZBX_DC_TREND *trends, int trends_num, zbx
 
 	zbx_db_free_result(result);
 
+	for (i = 0; i < updated_num; i++)
+		updated[i]->itemid = 0;
+
+	zbx_free(updated);
+
 	zbx_db_end_multiple_update(&sql, &sql_alloc, &sql_offset);
 
 	if (sql_offset > 16)	/* In ORACLE always present begin..end; */
@@ -949,6 +973,72 @@ int	zbx_trend_compare(const void *d1, const void *d2)
 	return 0;
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: merge partial aggregates of the same item hour                    *
+ *                                                                            *
+ * Parameters: trends     - [IN/OUT] trends sorted with zbx_trend_compare()   *
+ *             trends_num - [IN/OUT] number of trends                         *
+ *                                                                            *
+ * Comments: The same item hour is flushed more than once when values for     *
+ *           different hours are interleaved (late proxy data). Merging them  *
+ *           in memory results in single insert or update per item hour       *
+ *           instead of inserting the first and fetching it back from         *
+ *           database to update with the following ones.                      *
+ *                                                                            *
+ ******************************************************************************/
+void	zbx_merge_trends(ZBX_DC_TREND *trends, int *trends_num)
+{
+	int		i, j, num;
+	ZBX_DC_TREND	*dst, *src;
+
+	for (i = 0, num = 0; i < *trends_num; i++)
+	{
+		src = &trends[i];
+
+		/* same item hour with different value type can be between the merged trends */
+		for (j = num - 1; 0 <= j && 0 == zbx_trend_compare(&trends[j], src); j--)
+		{
+			dst = &trends[j];
+
+			if (dst->value_type != src->value_type)
+				continue;
+
+			switch (src->value_type)
+			{
+				case ITEM_VALUE_TYPE_FLOAT:
+					if (src->value_min.dbl < dst->value_min.dbl)
+						dst->value_min.dbl = src->value_min.dbl;
+					if (src->value_max.dbl > dst->value_max.dbl)
+						dst->value_max.dbl = src->value_max.dbl;
+					dst->value_avg.dbl = dst->value_avg.dbl / (dst->num + src->num) * dst->num +
+							src->value_avg.dbl / (dst->num + src->num) * src->num;
+					break;
+				case ITEM_VALUE_TYPE_UINT64:
+					if (src->value_min.ui64 < dst->value_min.ui64)
+						dst->value_min.ui64 = src->value_min.ui64;
+					if (src->value_max.ui64 > dst->value_max.ui64)
+						dst->value_max.ui64 = src->value_max.ui64;
+					/* unsigned trend average holds sum of values until it's written to database */
+					zbx_uinc128_128(&dst->value_avg.ui64, &src->value_avg.ui64);
+					break;
+			}
+
+			dst->num += src->num;
+			break;
+		}
+
+		if (0 <= j && 0 == zbx_trend_compare(&trends[j], src))
+			continue;
+
+		if (num != i)
+			memcpy(&trends[num], src, sizeof(ZBX_DC_TREND));
+		num++;
+	}
+
+	*trends_num = num;
+}
+
 typedef struct
 {
 	zbx_uint64_t		hostid;
@@ -1633,7 +1723,10 @@ static void	DCsync_trends(void)
 		DCexport_all_trends(trends, trends_num);
 
 	if (0 < trends_num)
+	{
 		qsort(trends, trends_num, sizeof(ZBX_DC_TREND), zbx_trend_compare);
+		zbx_merge_trends(trends, &trends_num);
+	}
 
 	zbx_db_begin();
 
@@ -17,6 +17,7 @@
 #include "zbxmutexs.h"
 #include "zbxtime.h"
 #include "zbxvariant.h"
+#include "zbxnix.h"
 
 /*
  * The cache (zbx_vc_cache_t) is organized as a hashset of item records (zbx_vc_item_t).
@@ -84,6 +85,25 @@ ZBX_SHMEM_FUNC_IMPL(__vc, vc_mem)
 
 #define ZBX_VC_ITEM_EXPIRE_PERIOD	SEC_PER_DAY
 
+/* the period of values read for items during warm-up */
+#define ZBX_VC_WARMUP_PERIOD		(10 * SEC_PER_MIN)
+
+/* the number of items read from database with single query during warm-up */
+#define ZBX_VC_WARMUP_BATCH_SIZE	1000
+
+/* warm-up leaves at least this percentage of cache free for regular requests */
+#define ZBX_VC_WARMUP_MIN_FREE_PCT	50
+
+/* value cache snapshot file identifier ("ZBVC") and format version */
+#define ZBX_VC_SNAPSHOT_MAGIC		0x5a425643
+#define ZBX_VC_SNAPSHOT_VERSION		1
+
+/* the string length used to store NULL strings in snapshot */
+#define ZBX_VC_SNAPSHOT_NULL_STR	0xffffffff
+
+/* the maximum string length accepted when reading snapshot */
+#define ZBX_VC_SNAPSHOT_MAX_STR		(16 * ZBX_MEBIBYTE)
+
 /* the data chunk used to store data fragment */
 typedef struct zbx_vc_chunk
 {
@@ -206,6 +226,15 @@ typedef struct
 
 	/* the string pool for str, text and log item values */
 	zbx_hashset_t	strpool;
+
+	/* the warm-up progress, updated by history syncers */
+	zbx_vc_warmup_stats_t	warmup;
+
+	/* the number of history syncers performing warm-up */
+	int			warmup_running;
+
+	/* set if any history syncer stopped warm-up on low cache space */
+	int			warmup_stopped;
 }
 zbx_vc_cache_t;
 
@@ -2799,6 +2828,24 @@ void	zbx_vc_get_mem_stats(zbx_shmem_stats_t *mem)
 	UNLOCK_CACHE;
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: get value cache warm-up progress                                  *
+ *                                                                            *
+ ******************************************************************************/
+void	zbx_vc_get_warmup_stats(zbx_vc_warmup_stats_t *stats)
+{
+	if (ZBX_VC_DISABLED == vc_state)
+	{
+		memset(stats, 0, sizeof(zbx_vc_warmup_stats_t));
+		return;
+	}
+
+	RDLOCK_CACHE;
+	*stats = vc_cache->warmup;
+	UNLOCK_CACHE;
+}
+
 /******************************************************************************
  *                                                                            *
  * Purpose: get statistics of cached items                                    *
@@ -2881,6 +2928,233 @@ void	zbx_vc_flush_stats(void)
 	zbx_vector_vc_itemupdate_clear(&vc_itemupdates);
 }
 
+static int	vc_item_pair_compare_func(const void *d1, const void *d2)
+{
+	const zbx_uint64_pair_t	*p1 = (const zbx_uint64_pair_t *)d1;
+	const zbx_uint64_pair_t	*p2 = (const zbx_uint64_pair_t *)d2;
+
+	ZBX_RETURN_IF_NOT_EQUAL(p1->second, p2->second);
+	ZBX_RETURN_IF_NOT_EQUAL(p1->first, p2->first);
+
+	return 0;
+}
+
+static int	vc_item_record_compare_func(const void *d1, const void *d2)
+{
+	const zbx_history_item_record_t	*r1 = (const zbx_history_item_record_t *)d1;
+	const zbx_history_item_record_t	*r2 = (const zbx_history_item_record_t *)d2;
+
+	ZBX_RETURN_IF_NOT_EQUAL(r1->itemid, r2->itemid);
+
+	return zbx_timespec_compare(&r1->record.timestamp, &r2->record.timestamp);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: cache values of items with the same value type                    *
+ *                                                                            *
+ * Parameters: itemids     - [IN] the item identifiers sorted in ascending    *
+ *                                order                                       *
+ *             itemids_num - [IN] the number of items                         *
+ *             value_type  - [IN] the items value type                        *
+ *             start       - [IN] the period start time (excluded)            *
+ *             now         - [IN] the current time                            *
+ *             cached_num  - [OUT] the number of items added to cache         *
+ *                                                                            *
+ * Return value: SUCCEED - the items were processed                           *
+ *               FAIL    - the cache cannot accept more items                 *
+ *                                                                            *
+ ******************************************************************************/
+static int	vc_warm_up_items(const zbx_uint64_t *itemids, int itemids_num, unsigned char value_type, int start,
+		int now, int *cached_num)
+{
+	zbx_vector_history_item_record_t	records;
+	zbx_vector_history_record_t		values;
+	int					i, j = 0, ret = SUCCEED, db_ret;
+	sigset_t				orig_mask;
+
+	zbx_vector_history_item_record_create(&records);
+	zbx_vector_history_record_create(&values);
+
+	/* Read without upper bound, as other history syncers might be already writing values of these items. */
+	/* Values written after the select are not lost either - zbx_vc_add_values() inserts trigger items     */
+	/* into cache, which are then skipped here and cached on demand.                                       */
+	/* database APIs might not handle signals correctly and hang, block signals to avoid hanging */
+	zbx_block_signals(&orig_mask);
+	db_ret = zbx_history_get_items_values(itemids, itemids_num, value_type, start, ZBX_JAN_2038, &records);
+	zbx_unblock_signals(&orig_mask);
+
+	if (SUCCEED != db_ret)
+		goto out;
+
+	zbx_vector_history_item_record_sort(&records, vc_item_record_compare_func);
+
+	WRLOCK_CACHE;
+
+	for (i = 0; i < itemids_num; i++)
+	{
+		zbx_vc_item_t	*item;
+
+		zbx_vector_history_record_clear(&values);
+
+		for (; j < records.values_num && records.values[j].itemid <= itemids[i]; j++)
+		{
+			if (records.values[j].itemid == itemids[i])
+				zbx_vector_history_record_append_ptr(&values, &records.values[j].record);
+		}
+
+		if (ZBX_VC_MODE_NORMAL != vc_cache->mode ||
+				vc_mem->free_size < vc_mem->total_size / 100 * ZBX_VC_WARMUP_MIN_FREE_PCT)
+		{
+			ret = FAIL;
+			break;
+		}
+
+		/* items cached by regular requests already have the required values */
+		if (NULL != zbx_hashset_search(&vc_cache->items, &itemids[i]))
+			continue;
+
+		zbx_vc_item_t	item_local = {
+				.itemid = itemids[i],
+				.value_type = value_type,
+				.last_accessed = now
+		};
+
+		if (NULL == (item = (zbx_vc_item_t *)zbx_hashset_insert(&vc_cache->items, &item_local,
+				sizeof(item_local))))
+		{
+			ret = FAIL;
+			break;
+		}
+
+		if (0 != values.values_num && SUCCEED != vch_item_add_values_at_tail(item, values.values,
+				values.values_num))
+		{
+			vc_remove_item(item);
+			ret = FAIL;
+			break;
+		}
+
+		vc_item_update_db_cached_from(item, start + 1);
+		(*cached_num)++;
+	}
+
+	UNLOCK_CACHE;
+out:
+	/* record values are owned by records vector */
+	zbx_vector_history_record_destroy(&values);
+	zbx_history_item_record_vector_destroy(&records, value_type);
+
+	return ret;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: pre-fill value cache with recent values of the specified items    *
+ *                                                                            *
+ * Parameters: items - [IN/OUT] the itemid, value type pairs, sorted by the   *
+ *                              function                                      *
+ *                                                                            *
+ * Comments: After restart value cache is empty and every item referenced in  *
+ *           trigger expressions is read from database with separate queries. *
+ *           Warm-up reads the last ZBX_VC_WARMUP_PERIOD of values for        *
+ *           batches of items with single query per value type. Warm-up is    *
+ *           stopped when cache is filled up to ZBX_VC_WARMUP_MIN_FREE_PCT,   *
+ *           the remaining items are cached on demand. Warm-up is also        *
+ *           stopped when the process is being terminated.                    *
+ *           Progress of all history syncers is summed in value cache and     *
+ *           is available in value cache diagnostic information.              *
+ *                                                                            *
+ ******************************************************************************/
+void	zbx_vc_warm_up(zbx_vector_uint64_pair_t *items)
+{
+	int			i, batch_num, now, cached_num = 0, cached_prev, processed_num = 0, ret = SUCCEED;
+	double			time_start, time_log;
+	const char		*stop_reason;
+	zbx_vector_uint64_t	itemids;
+
+	if (ZBX_VC_DISABLED == vc_state || 0 == items->values_num)
+		return;
+
+	zabbix_log(LOG_LEVEL_DEBUG, "In %s() items:%d", __func__, items->values_num);
+
+	time_start = time_log = zbx_time();
+	now = (int)time(NULL);
+
+	zbx_vector_uint64_create(&itemids);
+	zbx_vector_uint64_reserve(&itemids, ZBX_VC_WARMUP_BATCH_SIZE);
+
+	WRLOCK_CACHE;
+	vc_cache->warmup.items_num += (zbx_uint64_t)items->values_num;
+	vc_cache->warmup.state = ZBX_VC_WARMUP_STATE_RUNNING;
+	vc_cache->warmup_running++;
+	UNLOCK_CACHE;
+
+	/* group items by value type, ordered by itemid */
+	zbx_vector_uint64_pair_sort(items, vc_item_pair_compare_func);
+
+	for (i = 0; i < items->values_num && SUCCEED == ret && ZBX_IS_RUNNING(); i += batch_num)
+	{
+		unsigned char	value_type = (unsigned char)items->values[i].second;
+
+		zbx_vector_uint64_clear(&itemids);
+
+		for (batch_num = 0; i + batch_num < items->values_num && ZBX_VC_WARMUP_BATCH_SIZE > batch_num;
+				batch_num++)
+		{
+			if (value_type != items->values[i + batch_num].second)
+				break;
+
+			zbx_vector_uint64_append(&itemids, items->values[i + batch_num].first);
+		}
+
+		cached_prev = cached_num;
+		ret = vc_warm_up_items(itemids.values, itemids.values_num, value_type, now - ZBX_VC_WARMUP_PERIOD, now,
+				&cached_num);
+
+		processed_num += batch_num;
+
+		WRLOCK_CACHE;
+		vc_cache->warmup.processed_num += (zbx_uint64_t)batch_num;
+		vc_cache->warmup.cached_num += (zbx_uint64_t)(cached_num - cached_prev);
+		UNLOCK_CACHE;
+
+		if (SEC_PER_MIN < zbx_time() - time_log)
+		{
+			zabbix_log(LOG_LEVEL_INFORMATION, "value cache warm-up: %d of %d items processed, %d cached",
+					processed_num, items->values_num, cached_num);
+			time_log = zbx_time();
+		}
+	}
+
+	zbx_vector_uint64_destroy(&itemids);
+
+	WRLOCK_CACHE;
+
+	if (SUCCEED != ret || i < items->values_num)
+		vc_cache->warmup_stopped = 1;
+
+	if (0 == --vc_cache->warmup_running)
+	{
+		vc_cache->warmup.state = 0 == vc_cache->warmup_stopped ? ZBX_VC_WARMUP_STATE_FINISHED :
+				ZBX_VC_WARMUP_STATE_STOPPED;
+	}
+
+	UNLOCK_CACHE;
+
+	if (SUCCEED != ret)
+		stop_reason = "stopped on low cache space";
+	else if (i < items->values_num)
+		stop_reason = "interrupted";
+	else
+		stop_reason = "finished";
+
+	zabbix_log(LOG_LEVEL_INFORMATION, "value cache warm-up %s: %d of %d items cached in " ZBX_FS_DBL " sec",
+			stop_reason, cached_num, items->values_num, zbx_time() - time_start);
+
+	zabbix_log(LOG_LEVEL_DEBUG, "End of %s()", __func__);
+}
+
 /******************************************************************************
  *                                                                            *
  * Purpose: add newly created items with triggers to value cachel              *
@@ -2920,3 +3194,607 @@ void	zbx_vc_add_new_items(const zbx_vector_uint64_pair_t *items)
 
 	UNLOCK_CACHE;
 }
+
+/* the value cache snapshot file header */
+typedef struct
+{
+	zbx_uint32_t	magic;
+	zbx_uint32_t	version;
+
+	/* the time when snapshot was written */
+	int		time;
+
+	/* the number of items stored in snapshot */
+	int		items_num;
+}
+zbx_vc_snapshot_header_t;
+
+static int	vc_snapshot_value_type_supported(unsigned char value_type)
+{
+	switch (value_type)
+	{
+		case ITEM_VALUE_TYPE_FLOAT:
+		case ITEM_VALUE_TYPE_UINT64:
+		case ITEM_VALUE_TYPE_STR:
+		case ITEM_VALUE_TYPE_TEXT:
+		case ITEM_VALUE_TYPE_LOG:
+			return SUCCEED;
+		default:
+			return FAIL;
+	}
+}
+
+static int	vc_snapshot_write_data(FILE *f, const void *data, size_t size)
+{
+	return 1 == fwrite(data, size, 1, f) ? SUCCEED : FAIL;
+}
+
+static int	vc_snapshot_write_str(FILE *f, const char *str)
+{
+	zbx_uint32_t	len;
+
+	len = (NULL == str ? ZBX_VC_SNAPSHOT_NULL_STR : (zbx_uint32_t)strlen(str));
+
+	if (SUCCEED != vc_snapshot_write_data(f, &len, sizeof(len)))
+		return FAIL;
+
+	if (ZBX_VC_SNAPSHOT_NULL_STR == len || 0 == len)
+		return SUCCEED;
+
+	return vc_snapshot_write_data(f, str, len);
+}
+
+static int	vc_snapshot_write_value(FILE *f, const zbx_history_record_t *record, unsigned char value_type)
+{
+	const zbx_log_value_t	*log;
+
+	if (SUCCEED != vc_snapshot_write_data(f, &record->timestamp, sizeof(record->timestamp)))
+		return FAIL;
+
+	switch (value_type)
+	{
+		case ITEM_VALUE_TYPE_FLOAT:
+			return vc_snapshot_write_data(f, &record->value.dbl, sizeof(record->value.dbl));
+		case ITEM_VALUE_TYPE_UINT64:
+			return vc_snapshot_write_data(f, &record->value.ui64, sizeof(record->value.ui64));
+		case ITEM_VALUE_TYPE_STR:
+		case ITEM_VALUE_TYPE_TEXT:
+			return vc_snapshot_write_str(f, record->value.str);
+		case ITEM_VALUE_TYPE_LOG:
+			log = record->value.log;
+
+			if (SUCCEED != vc_snapshot_write_data(f, &log->timestamp, sizeof(log->timestamp)) ||
+					SUCCEED != vc_snapshot_write_data(f, &log->logeventid, sizeof(int)) ||
+					SUCCEED != vc_snapshot_write_data(f, &log->severity, sizeof(log->severity)) ||
+					SUCCEED != vc_snapshot_write_str(f, log->source))
+			{
+				return FAIL;
+			}
+
+			return vc_snapshot_write_str(f, log->value);
+	}
+
+	return FAIL;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: writes item cache state and cached values to snapshot file        *
+ *                                                                            *
+ * Parameters: f    - [IN] the snapshot file                                  *
+ *             item - [IN] the item to write                                  *
+ *                                                                            *
+ * Return value: SUCCEED - the item was written successfully                  *
+ *               FAIL    - file write error                                   *
+ *                                                                            *
+ * Comments: Values are written in ascending (oldest first) order.            *
+ *                                                                            *
+ ******************************************************************************/
+static int	vc_snapshot_write_item(FILE *f, const zbx_vc_item_t *item)
+{
+	const zbx_vc_chunk_t	*chunk;
+	int			i, values_num = 0;
+
+	for (chunk = item->tail; NULL != chunk; chunk = chunk->next)
+		values_num += chunk->last_value - chunk->first_value + 1;
+
+	if (SUCCEED != vc_snapshot_write_data(f, &item->itemid, sizeof(item->itemid)) ||
+			SUCCEED != vc_snapshot_write_data(f, &item->value_type, sizeof(item->value_type)) ||
+			SUCCEED != vc_snapshot_write_data(f, &item->status, sizeof(item->status)) ||
+			SUCCEED != vc_snapshot_write_data(f, &item->active_range, sizeof(item->active_range)) ||
+			SUCCEED != vc_snapshot_write_data(f, &item->daily_range, sizeof(item->daily_range)) ||
+			SUCCEED != vc_snapshot_write_data(f, &item->db_cached_from, sizeof(item->db_cached_from)) ||
+			SUCCEED != vc_snapshot_write_data(f, &values_num, sizeof(values_num)))
+	{
+		return FAIL;
+	}
+
+	for (chunk = item->tail; NULL != chunk; chunk = chunk->next)
+	{
+		for (i = chunk->first_value; i <= chunk->last_value; i++)
+		{
+			if (SUCCEED != vc_snapshot_write_value(f, &chunk->slots[i], item->value_type))
+				return FAIL;
+		}
+	}
+
+	return SUCCEED;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: saves value cache contents to snapshot file                       *
+ *                                                                            *
+ * Parameters: filename - [IN] the snapshot file name                         *
+ *             error    - [OUT] the error message                             *
+ *                                                                            *
+ * Return value: SUCCEED - the snapshot was saved or value cache is disabled  *
+ *               FAIL    - otherwise                                          *
+ *                                                                            *
+ * Comments: The snapshot is written to temporary file which is renamed to    *
+ *           the target file name only after all data was written, so a       *
+ *           partially written snapshot is never loaded.                      *
+ *           The snapshot is stored in native byte order and is not portable  *
+ *           between hosts.                                                   *
+ *                                                                            *
+ ******************************************************************************/
+int	zbx_vc_save_snapshot(const char *filename, char **error)
+{
+	FILE				*f;
+	char				*filename_tmp;
+	zbx_vc_item_t			*item;
+	zbx_hashset_iter_t		iter;
+	zbx_vc_snapshot_header_t	header = {ZBX_VC_SNAPSHOT_MAGIC, ZBX_VC_SNAPSHOT_VERSION, 0, 0};
+	int				ret = FAIL;
+
+	if (NULL == vc_cache)
+		return SUCCEED;
+
+	zabbix_log(LOG_LEVEL_DEBUG, "In %s() filename:%s", __func__, filename);
+
+	filename_tmp = zbx_dsprintf(NULL, "%s.tmp", filename);
+
+	if (NULL == (f = fopen(filename_tmp, "wb")))
+	{
+		*error = zbx_dsprintf(*error, "cannot open file \"%s\": %s", filename_tmp, zbx_strerror(errno));
+		goto out;
+	}
+
+	RDLOCK_CACHE;
+
+	zbx_hashset_iter_reset(&vc_cache->items, &iter);
+	while (NULL != (item = (zbx_vc_item_t *)zbx_hashset_iter_next(&iter)))
+	{
+		if (SUCCEED == vc_snapshot_value_type_supported(item->value_type))
+			header.items_num++;
+	}
+
+	header.time = (int)time(NULL);
+
+	if (SUCCEED == (ret = vc_snapshot_write_data(f, &header, sizeof(header))))
+	{
+		zbx_hashset_iter_reset(&vc_cache->items, &iter);
+		while (NULL != (item = (zbx_vc_item_t *)zbx_hashset_iter_next(&iter)))
+		{
+			if (SUCCEED != vc_snapshot_value_type_supported(item->value_type))
+				continue;
+
+			if (SUCCEED != (ret = vc_snapshot_write_item(f, item)))
+				break;
+		}
+	}
+
+	UNLOCK_CACHE;
+
+	if (SUCCEED != ret)
+		*error = zbx_dsprintf(*error, "cannot write file \"%s\": %s", filename_tmp, zbx_strerror(errno));
+
+	if (0 != fclose(f) && SUCCEED == ret)
+	{
+		*error = zbx_dsprintf(*error, "cannot close file \"%s\": %s", filename_tmp, zbx_strerror(errno));
+		ret = FAIL;
+	}
+
+	if (SUCCEED == ret && 0 != rename(filename_tmp, filename))
+	{
+		*error = zbx_dsprintf(*error, "cannot rename file \"%s\" to \"%s\": %s", filename_tmp, filename,
+				zbx_strerror(errno));
+		ret = FAIL;
+	}
+
+	if (SUCCEED != ret)
+		unlink(filename_tmp);
+	else
+		zabbix_log(LOG_LEVEL_INFORMATION, "value cache snapshot saved: %d items", header.items_num);
+out:
+	zbx_free(filename_tmp);
+
+	zabbix_log(LOG_LEVEL_DEBUG, "End of %s():%s", __func__, zbx_result_string(ret));
+
+	return ret;
+}
+
+static int	vc_snapshot_read_data(FILE *f, void *data, size_t size)
+{
+	return 1 == fread(data, size, 1, f) ? SUCCEED : FAIL;
+}
+
+static int	vc_snapshot_read_str(FILE *f, char **str)
+{
+	zbx_uint32_t	len;
+
+	if (SUCCEED != vc_snapshot_read_data(f, &len, sizeof(len)))
+		return FAIL;
+
+	if (ZBX_VC_SNAPSHOT_NULL_STR == len)
+	{
+		*str = NULL;
+		return SUCCEED;
+	}
+
+	if (ZBX_VC_SNAPSHOT_MAX_STR < len)
+		return FAIL;
+
+	*str = (char *)zbx_malloc(NULL, len + 1);
+
+	if (0 != len && SUCCEED != vc_snapshot_read_data(f, *str, len))
+	{
+		zbx_free(*str);
+		return FAIL;
+	}
+
+	(*str)[len] = '\0';
+
+	return SUCCEED;
+}
+
+static int	vc_snapshot_read_value(FILE *f, zbx_history_record_t *record, unsigned char value_type)
+{
+	zbx_log_value_t	*log;
+
+	if (SUCCEED != vc_snapshot_read_data(f, &record->timestamp, sizeof(record->timestamp)))
+		return FAIL;
+
+	switch (value_type)
+	{
+		case ITEM_VALUE_TYPE_FLOAT:
+			return vc_snapshot_read_data(f, &record->value.dbl, sizeof(record->value.dbl));
+		case ITEM_VALUE_TYPE_UINT64:
+			return vc_snapshot_read_data(f, &record->value.ui64, sizeof(record->value.ui64));
+		case ITEM_VALUE_TYPE_STR:
+		case ITEM_VALUE_TYPE_TEXT:
+			if (SUCCEED != vc_snapshot_read_str(f, &record->value.str))
+				return FAIL;
+
+			if (NULL == record->value.str)
+				return FAIL;
+
+			return SUCCEED;
+		case ITEM_VALUE_TYPE_LOG:
+			log = (zbx_log_value_t *)zbx_malloc(NULL, sizeof(zbx_log_value_t));
+			log->source = NULL;
+			log->value = NULL;
+
+			if (SUCCEED != vc_snapshot_read_data(f, &log->timestamp, sizeof(log->timestamp)) ||
+					SUCCEED != vc_snapshot_read_data(f, &log->logeventid, sizeof(int)) ||
+					SUCCEED != vc_snapshot_read_data(f, &log->severity, sizeof(log->severity)) ||
+					SUCCEED != vc_snapshot_read_str(f, &log->source) ||
+					SUCCEED != vc_snapshot_read_str(f, &log->value) || NULL == log->value)
+			{
+				zbx_free(log->source);
+				zbx_free(log->value);
+				zbx_free(log);
+
+				return FAIL;
+			}
+
+			record->value.log = log;
+
+			return SUCCEED;
+	}
+
+	return FAIL;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: reads item cache state and cached values from snapshot file       *
+ *                                                                            *
+ * Parameters: f      - [IN] the snapshot file                                *
+ *             item   - [OUT] the item cache state                            *
+ *             values - [OUT] the item values in ascending order              *
+ *                                                                            *
+ * Return value: SUCCEED - the item was read successfully                     *
+ *               FAIL    - file read error or invalid file contents           *
+ *                                                                            *
+ ******************************************************************************/
+static int	vc_snapshot_read_item(FILE *f, zbx_vc_item_t *item, zbx_vector_history_record_t *values)
+{
+	int	i, values_num;
+
+	if (SUCCEED != vc_snapshot_read_data(f, &item->itemid, sizeof(item->itemid)) ||
+			SUCCEED != vc_snapshot_read_data(f, &item->value_type, sizeof(item->value_type)) ||
+			SUCCEED != vc_snapshot_read_data(f, &item->status, sizeof(item->status)) ||
+			SUCCEED != vc_snapshot_read_data(f, &item->active_range, sizeof(item->active_range)) ||
+			SUCCEED != vc_snapshot_read_data(f, &item->daily_range, sizeof(item->daily_range)) ||
+			SUCCEED != vc_snapshot_read_data(f, &item->db_cached_from, sizeof(item->db_cached_from)) ||
+			SUCCEED != vc_snapshot_read_data(f, &values_num, sizeof(values_num)))
+	{
+		return FAIL;
+	}
+
+	if (SUCCEED != vc_snapshot_value_type_supported(item->value_type) || 0 > values_num)
+		return FAIL;
+
+	for (i = 0; i < values_num; i++)
+	{
+		zbx_history_record_t	record;
+
+		if (SUCCEED != vc_snapshot_read_value(f, &record, item->value_type))
+			return FAIL;
+
+		/* values must be stored in ascending order */
+		if (0 != values->values_num &&
+				0 <= zbx_timespec_compare(&values->values[values->values_num - 1].timestamp,
+				&record.timestamp))
+		{
+			zbx_history_record_clear(&record, item->value_type);
+			return FAIL;
+		}
+
+		zbx_vector_history_record_append_ptr(values, &record);
+	}
+
+	return SUCCEED;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: adds values stored in history after the snapshot was written to   *
+ *          the restored items                                                *
+ *                                                                            *
+ * Parameters: items - [IN/OUT] the restored itemid, value type pairs         *
+ *             start - [IN] the period start time (excluded)                  *
+ *                                                                            *
+ ******************************************************************************/
+static void	vc_snapshot_fill_gap(zbx_vector_uint64_pair_t *items, int start)
+{
+	int					i, j, batch_num;
+	zbx_vector_uint64_t			itemids;
+
+	zbx_vector_uint64_create(&itemids);
+	zbx_vector_uint64_reserve(&itemids, ZBX_VC_WARMUP_BATCH_SIZE);
+
+	zbx_vector_uint64_pair_sort(items, vc_item_pair_compare_func);
+
+	for (i = 0; i < items->values_num; i += batch_num)
+	{
+		unsigned char				value_type = (unsigned char)items->values[i].second;
+		zbx_vc_item_t				*item = NULL;
+		zbx_vector_history_item_record_t	records;
+
+		zbx_vector_uint64_clear(&itemids);
+
+		for (batch_num = 0; i + batch_num < items->values_num && ZBX_VC_WARMUP_BATCH_SIZE > batch_num;
+				batch_num++)
+		{
+			if (value_type != items->values[i + batch_num].second)
+				break;
+
+			zbx_vector_uint64_append(&itemids, items->values[i + batch_num].first);
+		}
+
+		zbx_vector_history_item_record_create(&records);
+
+		if (SUCCEED != zbx_history_get_items_values(itemids.values, itemids.values_num, value_type, start,
+				ZBX_JAN_2038, &records))
+		{
+			/* restored items without the gap values would be treated as complete, */
+			/* drop them so they are cached on demand                               */
+			WRLOCK_CACHE;
+
+			for (j = 0; j < itemids.values_num; j++)
+				vc_remove_item_by_id(itemids.values[j]);
+
+			UNLOCK_CACHE;
+
+			zbx_history_item_record_vector_destroy(&records, value_type);
+			continue;
+		}
+
+		zbx_vector_history_item_record_sort(&records, vc_item_record_compare_func);
+
+		WRLOCK_CACHE;
+
+		for (j = 0; j < records.values_num; j++)
+		{
+			zbx_history_item_record_t	*record = &records.values[j];
+
+			if (NULL == item || item->itemid != record->itemid)
+			{
+				if (NULL == (item = (zbx_vc_item_t *)zbx_hashset_search(&vc_cache->items,
+						&record->itemid)))
+				{
+					continue;
+				}
+			}
+
+			/* skip values already restored from snapshot */
+			if (NULL != item->head && 0 <= zbx_history_record_compare_asc_func(
+					&item->head->slots[item->head->last_value], &record->record))
+			{
+				continue;
+			}
+
+			if (SUCCEED != vch_item_add_value_at_head(item, &record->record))
+			{
+				vc_remove_item(item);
+				item = NULL;
+			}
+		}
+
+		UNLOCK_CACHE;
+
+		zbx_history_item_record_vector_destroy(&records, value_type);
+	}
+
+	zbx_vector_uint64_destroy(&itemids);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: adds item restored from snapshot to value cache                   *
+ *                                                                            *
+ * Parameters: item_local - [IN] the item cache state                         *
+ *             values     - [IN] the item values in ascending order           *
+ *                                                                            *
+ * Return value: SUCCEED - the item was added or it was already cached        *
+ *               FAIL    - not enough space in value cache                    *
+ *                                                                            *
+ ******************************************************************************/
+static int	vc_snapshot_add_item(const zbx_vc_item_t *item_local, const zbx_vector_history_record_t *values)
+{
+	zbx_vc_item_t	*item;
+
+	if (NULL != zbx_hashset_search(&vc_cache->items, &item_local->itemid))
+		return SUCCEED;
+
+	if (NULL == (item = (zbx_vc_item_t *)zbx_hashset_insert(&vc_cache->items, item_local, sizeof(zbx_vc_item_t))))
+		return FAIL;
+
+	if (0 != values->values_num && SUCCEED != vch_item_add_values_at_tail(item, values->values,
+			values->values_num))
+	{
+		vc_remove_item(item);
+		return FAIL;
+	}
+
+	return SUCCEED;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: loads value cache contents from snapshot file                     *
+ *                                                                            *
+ * Parameters: filename - [IN] the snapshot file name                         *
+ *             error    - [OUT] the error message                             *
+ *                                                                            *
+ * Return value: SUCCEED - the snapshot was loaded or there was no snapshot   *
+ *               FAIL    - the snapshot cannot be loaded                      *
+ *                                                                            *
+ * Comments: The snapshot file is removed after reading, so that an outdated  *
+ *           snapshot is not loaded after server crash. Values stored in      *
+ *           history after the snapshot was written are read from database    *
+ *           with batched queries. Snapshots older than item expiration       *
+ *           period are ignored. If the snapshot contents are invalid the     *
+ *           already loaded items are dropped and cache is filled on demand.  *
+ *           This function must be called before history syncers are started. *
+ *                                                                            *
+ ******************************************************************************/
+int	zbx_vc_load_snapshot(const char *filename, char **error)
+{
+	FILE				*f;
+	int				i, now, ret = FAIL;
+	double				time_start;
+	zbx_vc_snapshot_header_t	header;
+	zbx_vector_history_record_t	values;
+	zbx_vector_uint64_pair_t	items;
+
+	if (ZBX_VC_DISABLED == vc_state)
+		return SUCCEED;
+
+	zabbix_log(LOG_LEVEL_DEBUG, "In %s() filename:%s", __func__, filename);
+
+	if (NULL == (f = fopen(filename, "rb")))
+	{
+		if (ENOENT == errno)
+		{
+			ret = SUCCEED;
+		}
+		else
+		{
+			*error = zbx_dsprintf(*error, "cannot open file \"%s\": %s", filename,
+					zbx_strerror(errno));
+		}
+
+		goto out;
+	}
+
+	time_start = zbx_time();
+	now = (int)time(NULL);
+
+	zbx_vector_history_record_create(&values);
+	zbx_vector_uint64_pair_create(&items);
+
+	if (SUCCEED != vc_snapshot_read_data(f, &header, sizeof(header)) || ZBX_VC_SNAPSHOT_MAGIC != header.magic ||
+			ZBX_VC_SNAPSHOT_VERSION != header.version || 0 > header.items_num)
+	{
+		*error = zbx_dsprintf(*error, "invalid file \"%s\" format", filename);
+		goto close;
+	}
+
+	if (header.time > now || ZBX_VC_ITEM_EXPIRE_PERIOD < now - header.time)
+	{
+		*error = zbx_dsprintf(*error, "snapshot \"%s\" is outdated", filename);
+		goto close;
+	}
+
+	zbx_vector_uint64_pair_reserve(&items, (size_t)header.items_num);
+
+	WRLOCK_CACHE;
+
+	for (i = 0, ret = SUCCEED; i < header.items_num; i++)
+	{
+		zbx_vc_item_t		item_local = {.last_accessed = now};
+		zbx_uint64_pair_t	pair;
+		int			full = 0;
+
+		if (SUCCEED != (ret = vc_snapshot_read_item(f, &item_local, &values)))
+			*error = zbx_dsprintf(*error, "invalid file \"%s\" contents", filename);
+		else if (ZBX_VC_MODE_NORMAL != vc_cache->mode || SUCCEED != vc_snapshot_add_item(&item_local, &values))
+			full = 1;
+		else
+		{
+			pair.first = item_local.itemid;
+			pair.second = item_local.value_type;
+			zbx_vector_uint64_pair_append(&items, pair);
+		}
+
+		if (0 != values.values_num)
+			zbx_history_record_vector_clean(&values, item_local.value_type);
+
+		/* when cache is full the rest of items will be cached on demand */
+		if (SUCCEED != ret || 0 != full)
+			break;
+	}
+
+	UNLOCK_CACHE;
+
+	if (SUCCEED != ret)
+	{
+		zbx_vc_reset();
+	}
+	else
+	{
+		/* values might have been written to history after the snapshot by other processes */
+		vc_snapshot_fill_gap(&items, header.time - 1);
+
+		zabbix_log(LOG_LEVEL_INFORMATION, "value cache snapshot loaded: %d of %d items restored in "
+				ZBX_FS_DBL " sec", items.values_num, header.items_num, zbx_time() - time_start);
+	}
+close:
+	zbx_vector_uint64_pair_destroy(&items);
+	zbx_vector_history_record_destroy(&values);
+
+	fclose(f);
+
+	if (0 != unlink(filename))
+	{
+		zabbix_log(LOG_LEVEL_WARNING, "cannot remove value cache snapshot file \"%s\": %s", filename,
+				zbx_strerror(errno));
+	}
+out:
+	zabbix_log(LOG_LEVEL_DEBUG, "End of %s():%s", __func__, zbx_result_string(ret));
+
+	return ret;
+}
@@ -1480,6 +1480,17 @@ int	zbx_tcp_listen(zbx_socket_t *s, const char *listen_ip, unsigned short listen
 						"IPV6_V6ONLY", NULL != ip ? ip : "-", port,
 						zbx_strerror_from_system(zbx_socket_last_error()));
 			}
+#endif
+#if defined(TCP_DEFER_ACCEPT)
+			/* peers always send data first - queue connections in kernel until data arrives, */
+			/* so that listeners are not held waiting for the first byte of a silent peer     */
+			if (ZBX_PROTO_ERROR == setsockopt(s->sockets[s->num_socks], IPPROTO_TCP, TCP_DEFER_ACCEPT,
+					(void *)&timeout, sizeof(timeout)))
+			{
+				zbx_set_socket_strerror("setsockopt() with %s for [[%s]:%s] failed: %s",
+						"TCP_DEFER_ACCEPT", NULL != ip ? ip : "-", port,
+						zbx_strerror_from_system(zbx_socket_last_error()));
+			}
 #endif
 			if (ZBX_PROTO_ERROR == zbx_bind(s->sockets[s->num_socks], current_ai->ai_addr,
 								current_ai->ai_addrlen))
@@ -1585,12 +1596,10 @@ int	zbx_tcp_accept(zbx_socket_t *s, unsigned int tls_accept, int poll_timeout)
 	int		i, ret = FAIL;
 	ssize_t		res;
 	char		buf;	/* 1 byte buffer */
-	zbx_pollfd_t	*pds;
+	zbx_pollfd_t	pds[ZBX_SOCKET_COUNT];
 
 	zbx_tcp_unaccept(s);
 
-	pds = (zbx_pollfd_t *)zbx_malloc(NULL, sizeof(zbx_pollfd_t) * (size_t)s->num_socks);
-
 	for (i = 0; i < s->num_socks; i++)
 	{
 		pds[i].fd = s->sockets[i];
@@ -1715,8 +1724,6 @@ int	zbx_tcp_accept(zbx_socket_t *s, unsigned int tls_accept, int poll_timeout)
 
 	ret = SUCCEED;
 out:
-	zbx_free(pds);
-
 	return ret;
 }
 
@@ -531,7 +531,8 @@ static int	comms_check_redirect(const char *data, zbx_vector_addr_ptr_t *addrs,
  ******************************************************************************/
 int	zbx_comms_exchange_with_redirect(const char *source_ip, zbx_vector_addr_ptr_t *addrs, int timeout,
 		int connect_timeout, int retry_interval, int loglevel, const zbx_config_tls_t *config_tls,
-		const char *data, char *(*connect_callback)(void *), void *cb_data, char **out, char **error)
+		const char *data, unsigned char flags, char *(*connect_callback)(void *), void *cb_data, char **out,
+		char **error)
 {
 	zbx_socket_t		sock;
 	int			ret = FAIL, retries = 0, retry = ZBX_REDIRECT_NONE;
@@ -556,7 +557,7 @@ retry:
 
 	zabbix_log(LOG_LEVEL_DEBUG, "%s() sending: %s", __func__, data);
 
-	if (SUCCEED != zbx_tcp_send(&sock, data))
+	if (SUCCEED != zbx_tcp_send_ext(&sock, data, strlen(data), 0, flags, 0))
 	{
 		zabbix_log(LOG_LEVEL_DEBUG, "unable to send to [%s]:%d: %s",
 				addrs->values[0]->ip, addrs->values[0]->port, zbx_socket_strerror());
@@ -28,6 +28,7 @@
 #include "zbxrtc.h"
 #include "zbx_rtc_constants.h"
 #include "zbxipcservice.h"
+#include "zbxcachevalue.h"
 
 static sigset_t			orig_mask;
 
@@ -85,6 +86,27 @@ static void	zbx_db_flush_timer_queue(void)
 	zbx_vector_trigger_timer_ptr_destroy(&persistent_timers);
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: cache recent values of items used in triggers before starting     *
+ *          history synchronization                                           *
+ *                                                                            *
+ * Parameters: process_num   - [IN] history syncer process number             *
+ *             process_forks - [IN] number of history syncer processes        *
+ *                                                                            *
+ ******************************************************************************/
+static void	dbsyncer_warm_up_value_cache(int process_num, int process_forks)
+{
+	zbx_vector_uint64_pair_t	items;
+
+	zbx_vector_uint64_pair_create(&items);
+
+	zbx_dc_config_history_sync_get_trigger_items(&items, process_num, process_forks);
+	zbx_vc_warm_up(&items);
+
+	zbx_vector_uint64_pair_destroy(&items);
+}
+
 static void	db_trigger_queue_cleanup(void)
 {
 	zbx_db_execute("delete from trigger_queue");
@@ -150,6 +172,14 @@ ZBX_THREAD_ENTRY(zbx_dbsyncer_thread, args)
 
 	zbx_rtc_subscribe(process_type, process_num, rtc_msgs, ARRSIZE(rtc_msgs), dbsyncer_args->config_timeout, &rtc);
 
+	if (0 != (info->program_type & ZBX_PROGRAM_TYPE_SERVER))
+	{
+		zbx_setproctitle("%s #%d [warming up value cache]", process_name, process_num);
+
+		/* signals are blocked by warm-up around each database query */
+		dbsyncer_warm_up_value_cache(process_num, dbsyncer_args->get_config_forks(process_type));
+	}
+
 	for (;;)
 	{
 		unsigned char	*rtc_data = NULL;
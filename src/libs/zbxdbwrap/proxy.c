@@ -867,11 +867,94 @@ static void	log_client_timediff(int level, struct zbx_json_parse *jp, const zbx_
 	}
 }
 
+/* history data row fields, see history_row_tags[] for the corresponding tags */
+typedef enum
+{
+	ZBX_HISTORY_ROW_CLOCK = 0,
+	ZBX_HISTORY_ROW_NS,
+	ZBX_HISTORY_ROW_STATE,
+	ZBX_HISTORY_ROW_LASTLOGSIZE,
+	ZBX_HISTORY_ROW_MTIME,
+	ZBX_HISTORY_ROW_VALUE,
+	ZBX_HISTORY_ROW_LOGTIMESTAMP,
+	ZBX_HISTORY_ROW_LOGSOURCE,
+	ZBX_HISTORY_ROW_LOGSEVERITY,
+	ZBX_HISTORY_ROW_LOGEVENTID,
+	ZBX_HISTORY_ROW_ID,
+	ZBX_HISTORY_ROW_ITEMID,
+	ZBX_HISTORY_ROW_HOST,
+	ZBX_HISTORY_ROW_KEY,
+	ZBX_HISTORY_ROW_FIELDS_NUM
+}
+zbx_history_row_field_t;
+
+static const char	*history_row_tags[ZBX_HISTORY_ROW_FIELDS_NUM] = {
+		ZBX_PROTO_TAG_CLOCK, ZBX_PROTO_TAG_NS, ZBX_PROTO_TAG_STATE, ZBX_PROTO_TAG_LASTLOGSIZE,
+		ZBX_PROTO_TAG_MTIME, ZBX_PROTO_TAG_VALUE, ZBX_PROTO_TAG_LOGTIMESTAMP, ZBX_PROTO_TAG_LOGSOURCE,
+		ZBX_PROTO_TAG_LOGSEVERITY, ZBX_PROTO_TAG_LOGEVENTID, ZBX_PROTO_TAG_ID, ZBX_PROTO_TAG_ITEMID,
+		ZBX_PROTO_TAG_HOST, ZBX_PROTO_TAG_KEY};
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: locates history data row field values                             *
+ *                                                                            *
+ * Parameters: jp_row - [IN] JSON with history data row                       *
+ *             fields - [OUT] pointers to field values in JSON or NULL for    *
+ *                            missing fields, indexed by                      *
+ *                            zbx_history_row_field_t                         *
+ *                                                                            *
+ * Comments: Row is scanned once instead of searching each field by name,     *
+ *           which would scan the row for every field, including the missing  *
+ *           ones. As with search by name the first matching pair is used.    *
+ *                                                                            *
+ ******************************************************************************/
+static void	parse_history_data_row_fields(const struct zbx_json_parse *jp_row, const char **fields)
+{
+	char		name[MAX_STRING_LEN];
+	const char	*p = NULL;
+	int		i;
+
+	memset(fields, 0, sizeof(const char *) * ZBX_HISTORY_ROW_FIELDS_NUM);
+
+	while (NULL != (p = zbx_json_pair_next(jp_row, p, name, sizeof(name))))
+	{
+		for (i = 0; i < ZBX_HISTORY_ROW_FIELDS_NUM; i++)
+		{
+			if (0 == strcmp(history_row_tags[i], name))
+			{
+				if (NULL == fields[i])
+					fields[i] = p;
+				break;
+			}
+		}
+	}
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: decodes history data row field value                              *
+ *                                                                            *
+ * Parameters: field        - [IN] the field value in JSON, can be NULL       *
+ *             string       - [IN/OUT] the decoded value                      *
+ *             string_alloc - [IN/OUT] the decoded value buffer size          *
+ *                                                                            *
+ * Return value:  SUCCEED - the field value was decoded                       *
+ *                FAIL    - the field is missing or is not a primitive value  *
+ *                                                                            *
+ ******************************************************************************/
+static int	parse_history_data_row_field(const char *field, char **string, size_t *string_alloc)
+{
+	if (NULL == field || NULL == zbx_json_decodevalue_dyn(field, string, string_alloc, NULL))
+		return FAIL;
+
+	return SUCCEED;
+}
+
 /******************************************************************************
  *                                                                            *
  * Purpose: parses agent value from history data json row                     *
  *                                                                            *
- * Parameters: jp_row       - [IN] JSON with history data row                 *
+ * Parameters: fields       - [IN] history data row field values              *
  *             unique_shift - [IN/OUT] auto increment nanoseconds to ensure   *
  *                                     unique value of timestamps             *
  *             av           - [OUT] the agent value                           *
@@ -880,8 +963,7 @@ static void	log_client_timediff(int level, struct zbx_json_parse *jp, const zbx_
  *                FAIL    - otherwise                                         *
  *                                                                            *
  ******************************************************************************/
-static int	parse_history_data_row_value(const struct zbx_json_parse *jp_row, zbx_timespec_t *unique_shift,
-		zbx_agent_value_t *av)
+static int	parse_history_data_row_value(const char **fields, zbx_timespec_t *unique_shift, zbx_agent_value_t *av)
 {
 	char	*tmp = NULL;
 	size_t	tmp_alloc = 0;
@@ -889,12 +971,12 @@ static int	parse_history_data_row_value(const struct zbx_json_parse *jp_row, zbx
 
 	memset(av, 0, sizeof(zbx_agent_value_t));
 
-	if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_CLOCK, &tmp, &tmp_alloc, NULL))
+	if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_CLOCK], &tmp, &tmp_alloc))
 	{
 		if (FAIL == zbx_is_uint31(tmp, &av->ts.sec))
 			goto out;
 
-		if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_NS, &tmp, &tmp_alloc, NULL))
+		if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_NS], &tmp, &tmp_alloc))
 		{
 			if (FAIL == zbx_is_uint_n_range(tmp, tmp_alloc, &av->ts.ns, sizeof(av->ts.ns),
 				0LL, 999999999LL))
@@ -919,40 +1001,40 @@ static int	parse_history_data_row_value(const struct zbx_json_parse *jp_row, zbx
 	else
 		zbx_timespec(&av->ts);
 
-	if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_STATE, &tmp, &tmp_alloc, NULL))
+	if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_STATE], &tmp, &tmp_alloc))
 		av->state = (unsigned char)atoi(tmp);
 
 	/* Unsupported item meta information must be ignored for backwards compatibility. */
 	/* New agents will not send meta information for items in unsupported state.      */
 	if (ITEM_STATE_NOTSUPPORTED != av->state)
 	{
-		if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_LASTLOGSIZE, &tmp, &tmp_alloc, NULL))
+		if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_LASTLOGSIZE], &tmp, &tmp_alloc))
 		{
 			av->meta = 1;	/* contains meta information */
 
 			zbx_is_uint64(tmp, &av->lastlogsize);
 
-			if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_MTIME, &tmp, &tmp_alloc, NULL))
+			if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_MTIME], &tmp, &tmp_alloc))
 				av->mtime = atoi(tmp);
 		}
 	}
 
-	if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_VALUE, &tmp, &tmp_alloc, NULL))
+	if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_VALUE], &tmp, &tmp_alloc))
 		av->value = zbx_strdup(av->value, tmp);
 
-	if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_LOGTIMESTAMP, &tmp, &tmp_alloc, NULL))
+	if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_LOGTIMESTAMP], &tmp, &tmp_alloc))
 		av->timestamp = atoi(tmp);
 
-	if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_LOGSOURCE, &tmp, &tmp_alloc, NULL))
+	if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_LOGSOURCE], &tmp, &tmp_alloc))
 		av->source = zbx_strdup(av->source, tmp);
 
-	if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_LOGSEVERITY, &tmp, &tmp_alloc, NULL))
+	if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_LOGSEVERITY], &tmp, &tmp_alloc))
 		av->severity = atoi(tmp);
 
-	if (SUCCEED == zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_LOGEVENTID, &tmp, &tmp_alloc, NULL))
+	if (SUCCEED == parse_history_data_row_field(fields[ZBX_HISTORY_ROW_LOGEVENTID], &tmp, &tmp_alloc))
 		av->logeventid = atoi(tmp);
 
-	if (SUCCEED != zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_ID, &tmp, &tmp_alloc, NULL) ||
+	if (SUCCEED != parse_history_data_row_field(fields[ZBX_HISTORY_ROW_ID], &tmp, &tmp_alloc) ||
 			SUCCEED != zbx_is_uint64(tmp, &av->id))
 	{
 		av->id = 0;
@@ -969,19 +1051,22 @@ out:
  *                                                                            *
  * Purpose: parses item identifier from history data json row                 *
  *                                                                            *
- * Parameters: jp_row - [IN] JSON with history data row                       *
+ * Parameters: fields - [IN] history data row field values                    *
  *             itemid - [OUT] the item identifier                             *
  *                                                                            *
  * Return value:  SUCCEED - the item identifier was parsed successfully       *
  *                FAIL    - otherwise                                         *
  *                                                                            *
  ******************************************************************************/
-static int	parse_history_data_row_itemid(const struct zbx_json_parse *jp_row, zbx_uint64_t *itemid)
+static int	parse_history_data_row_itemid(const char **fields, zbx_uint64_t *itemid)
 {
 	char	buffer[MAX_ID_LEN + 1];
 
-	if (SUCCEED != zbx_json_value_by_name(jp_row, ZBX_PROTO_TAG_ITEMID, buffer, sizeof(buffer), NULL))
+	if (NULL == fields[ZBX_HISTORY_ROW_ITEMID] ||
+			NULL == zbx_json_decodevalue(fields[ZBX_HISTORY_ROW_ITEMID], buffer, sizeof(buffer), NULL))
+	{
 		return FAIL;
+	}
 
 	if (SUCCEED != zbx_is_uint64(buffer, itemid))
 		return FAIL;
@@ -992,27 +1077,27 @@ static int	parse_history_data_row_itemid(const struct zbx_json_parse *jp_row, zb
  *                                                                            *
  * Purpose: parses host,key pair from history data json row                   *
  *                                                                            *
- * Parameters: jp_row - [IN] JSON with history data row                       *
+ * Parameters: fields - [IN] history data row field values                    *
  *             hk     - [OUT] the host,key pair                               *
  *                                                                            *
  * Return value:  SUCCEED - the host,key pair was parsed successfully         *
  *                FAIL    - otherwise                                         *
  *                                                                            *
  ******************************************************************************/
-static int	parse_history_data_row_hostkey(const struct zbx_json_parse *jp_row, zbx_host_key_t *hk)
+static int	parse_history_data_row_hostkey(const char **fields, zbx_host_key_t *hk)
 {
 	size_t str_alloc;
 
 	str_alloc = 0;
 	zbx_free(hk->host);
 
-	if (SUCCEED != zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_HOST, &hk->host, &str_alloc, NULL))
+	if (SUCCEED != parse_history_data_row_field(fields[ZBX_HISTORY_ROW_HOST], &hk->host, &str_alloc))
 		return FAIL;
 
 	str_alloc = 0;
 	zbx_free(hk->key);
 
-	if (SUCCEED != zbx_json_value_by_name_dyn(jp_row, ZBX_PROTO_TAG_KEY, &hk->key, &str_alloc, NULL))
+	if (SUCCEED != parse_history_data_row_field(fields[ZBX_HISTORY_ROW_KEY], &hk->key, &str_alloc))
 	{
 		zbx_free(hk->host);
 		return FAIL;
@@ -1045,6 +1130,7 @@ static int	parse_history_data(struct zbx_json_parse *jp_data, const char **pnext
 		zbx_host_key_t *hostkeys, int *values_num, int *parsed_num, zbx_timespec_t *unique_shift)
 {
 	struct zbx_json_parse	jp_row;
+	const char		*fields[ZBX_HISTORY_ROW_FIELDS_NUM];
 	int			ret = FAIL;
 
 	zabbix_log(LOG_LEVEL_DEBUG, "In %s()", __func__);
@@ -1072,10 +1158,12 @@ static int	parse_history_data(struct zbx_json_parse *jp_data, const char **pnext
 
 		(*parsed_num)++;
 
-		if (SUCCEED != parse_history_data_row_hostkey(&jp_row, &hostkeys[*values_num]))
+		parse_history_data_row_fields(&jp_row, fields);
+
+		if (SUCCEED != parse_history_data_row_hostkey(fields, &hostkeys[*values_num]))
 			continue;
 
-		if (SUCCEED != parse_history_data_row_value(&jp_row, unique_shift, &values[*values_num]))
+		if (SUCCEED != parse_history_data_row_value(fields, unique_shift, &values[*values_num]))
 			continue;
 
 		(*values_num)++;
@@ -1120,6 +1208,7 @@ static int	parse_history_data_by_itemids(struct zbx_json_parse *jp_data, const c
 		zbx_timespec_t *unique_shift, char **error)
 {
 	struct zbx_json_parse	jp_row;
+	const char		*fields[ZBX_HISTORY_ROW_FIELDS_NUM];
 	int			ret = FAIL;
 
 	zabbix_log(LOG_LEVEL_DEBUG, "In %s()", __func__);
@@ -1147,10 +1236,12 @@ static int	parse_history_data_by_itemids(struct zbx_json_parse *jp_data, const c
 
 		(*parsed_num)++;
 
-		if (SUCCEED != parse_history_data_row_itemid(&jp_row, &itemids[*values_num]))
+		parse_history_data_row_fields(&jp_row, fields);
+
+		if (SUCCEED != parse_history_data_row_itemid(fields, &itemids[*values_num]))
 			continue;
 
-		if (SUCCEED != parse_history_data_row_value(&jp_row, unique_shift, &values[*values_num]))
+		if (SUCCEED != parse_history_data_row_value(fields, unique_shift, &values[*values_num]))
 			continue;
 
 		(*values_num)++;
@@ -172,6 +172,8 @@ void	zbx_diag_add_mem_stats(struct zbx_json *json, const char *name, const zbx_s
 	zbx_json_adduint64(json, "used", stats->used_size);
 	zbx_json_close(json);
 
+	zbx_json_adduint64(json, "huge_pages", stats->huge_pages);
+
 	zbx_json_addobject(json, "chunks");
 	zbx_json_adduint64(json, "free", stats->free_chunks);
 	zbx_json_adduint64(json, "used", stats->used_chunks);
@@ -207,6 +207,36 @@ int	zbx_write_all(int fd, const char *buf, size_t n)
 
 #endif	/* not _WINDOWS */
 
+/* evaluates to non-zero if any byte of 64-bit word is zero */
+#define ZBX_WORD_HAS_ZERO_BYTE(word)									\
+	(((word) - __UINT64_C(0x0101010101010101)) & ~(word) & __UINT64_C(0x8080808080808080))
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: checks if 8 bytes at the specified location contain NUL, CR or LF *
+ *                                                                            *
+ * Return value: SUCCEED - at least one of the bytes is NUL, CR or LF         *
+ *               FAIL    - otherwise                                          *
+ *                                                                            *
+ ******************************************************************************/
+static int	word_has_newline_or_nul(const char *p)
+{
+	zbx_uint64_t	word;
+
+	memcpy(&word, p, sizeof(word));
+
+	if (0 != ZBX_WORD_HAS_ZERO_BYTE(word) ||
+			0 != ZBX_WORD_HAS_ZERO_BYTE(word ^ __UINT64_C(0x0a0a0a0a0a0a0a0a)) ||
+			0 != ZBX_WORD_HAS_ZERO_BYTE(word ^ __UINT64_C(0x0d0d0d0d0d0d0d0d)))
+	{
+		return SUCCEED;
+	}
+
+	return FAIL;
+}
+
+#undef ZBX_WORD_HAS_ZERO_BYTE
+
 /******************************************************************************
  *                                                                            *
  * Purpose: find next newline in buffer using newline encoding                *
@@ -230,6 +260,13 @@ char	*zbx_find_buf_newline(char *p, char **p_next, const char *p_end, const char
 	{
 		for (; p < p_end; p++)
 		{
+			/* skip whole words without newline or NULL bytes instead of checking them byte by byte */
+			while ((size_t)(p_end - p) >= sizeof(zbx_uint64_t) && FAIL == word_has_newline_or_nul(p))
+				p += sizeof(zbx_uint64_t);
+
+			if (p == p_end)
+				break;
+
 			/* detect NULL byte and replace it with '?' character */
 			if (0x0 == *p)
 			{
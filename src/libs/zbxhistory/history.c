@@ -20,6 +20,7 @@
 #include "zbxprof.h"
 
 ZBX_VECTOR_IMPL(history_record, zbx_history_record_t)
+ZBX_VECTOR_IMPL(history_item_record, zbx_history_item_record_t)
 
 ZBX_PTR_VECTOR_IMPL(dc_history_ptr, zbx_dc_history_t *)
 
@@ -189,6 +190,69 @@ int	zbx_history_get_values(zbx_uint64_t itemid, int value_type, int start, int c
 	return ret;
 }
 
+/************************************************************************************
+ *                                                                                  *
+ * Purpose: gets values of multiple items from history storage                      *
+ *                                                                                  *
+ * Parameters:  itemids     - [IN] the itemids                                      *
+ *              itemids_num - [IN] the number of itemids                            *
+ *              value_type  - [IN] the items value type                             *
+ *              start       - [IN] the period start timestamp                       *
+ *              end         - [IN] the period end timestamp                         *
+ *              values      - [OUT] the items history data values                   *
+ *                                                                                  *
+ * Return value: SUCCEED - the history data were read successfully                  *
+ *               FAIL - otherwise                                                   *
+ *                                                                                  *
+ * Comments: This function reads all values from ]<start>,<end>] interval in        *
+ *           undefined order. Storages without multiple item support are queried    *
+ *           item by item.                                                          *
+ *                                                                                  *
+ ************************************************************************************/
+int	zbx_history_get_items_values(const zbx_uint64_t *itemids, int itemids_num, int value_type, int start, int end,
+		zbx_vector_history_item_record_t *values)
+{
+	int				ret = SUCCEED, pos;
+	zbx_history_iface_t		*writer = &history_ifaces[value_type];
+	zbx_vector_history_record_t	records;
+
+	zabbix_log(LOG_LEVEL_DEBUG, "In %s() itemids_num:%d value_type:%d start:%d end:%d", __func__, itemids_num,
+			value_type, start, end);
+
+	pos = values->values_num;
+
+	if (NULL != writer->get_items_values)
+	{
+		ret = writer->get_items_values(writer, itemids, itemids_num, start, end, values);
+		goto out;
+	}
+
+	zbx_history_record_vector_create(&records);
+
+	for (int i = 0; i < itemids_num && SUCCEED == ret; i++)
+	{
+		if (SUCCEED != (ret = writer->get_values(writer, itemids[i], start, 0, end, &records)))
+			break;
+
+		for (int j = 0; j < records.values_num; j++)
+		{
+			zbx_history_item_record_t	value = {.itemid = itemids[i], .record = records.values[j]};
+
+			zbx_vector_history_item_record_append_ptr(values, &value);
+		}
+
+		/* record values were moved to the output vector */
+		zbx_vector_history_record_clear(&records);
+	}
+
+	zbx_history_record_vector_destroy(&records, value_type);
+out:
+	zabbix_log(LOG_LEVEL_DEBUG, "End of %s():%s values:%d", __func__, zbx_result_string(ret),
+			values->values_num - pos);
+
+	return ret;
+}
+
 /************************************************************************************
  *                                                                                  *
  * Purpose: checks if the value type requires trends data calculations              *
@@ -209,6 +273,22 @@ int	zbx_history_requires_trends(int value_type)
 	return 0 != writer->requires_trends ? SUCCEED : FAIL;
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: destroys item value vector and frees resources allocated for it   *
+ *                                                                            *
+ * Parameters: vector     - [IN] the value vector                             *
+ *             value_type - [IN] the type of vector values                    *
+ *                                                                            *
+ ******************************************************************************/
+void	zbx_history_item_record_vector_destroy(zbx_vector_history_item_record_t *vector, int value_type)
+{
+	for (int i = 0; i < vector->values_num; i++)
+		zbx_history_record_clear(&vector->values[i].record, value_type);
+
+	zbx_vector_history_item_record_destroy(vector);
+}
+
 /******************************************************************************
  *                                                                            *
  * Purpose: frees history log and all resources allocated for it              *
@@ -28,6 +28,8 @@ typedef int (*zbx_history_add_values_func_t)(struct zbx_history_iface *hist, con
 		int config_history_storage_pipelines);
 typedef int (*zbx_history_get_values_func_t)(struct zbx_history_iface *hist, zbx_uint64_t itemid, int start,
 		int count, int end, zbx_vector_history_record_t *values);
+typedef int (*zbx_history_get_items_values_func_t)(struct zbx_history_iface *hist, const zbx_uint64_t *itemids,
+		int itemids_num, int start, int end, zbx_vector_history_item_record_t *values);
 typedef int (*zbx_history_flush_func_t)(struct zbx_history_iface *hist);
 
 typedef void (*zbx_history_func_t)(const zbx_vector_dc_history_ptr_t *);
@@ -44,6 +46,8 @@ struct zbx_history_iface
 	zbx_history_destroy_func_t	destroy;
 	zbx_history_add_values_func_t	add_values;
 	zbx_history_get_values_func_t	get_values;
+	/* optional, values are read per item with get_values() if not set */
+	zbx_history_get_items_values_func_t	get_items_values;
 	zbx_history_flush_func_t	flush;
 };
 
@@ -430,6 +430,96 @@ out:
 	elastic_close(hist);
 }
 
+/************************************************************************************
+ *                                                                                  *
+ * Purpose: finds history storage interface by its cURL handle                      *
+ *                                                                                  *
+ ************************************************************************************/
+static zbx_history_iface_t	*elastic_writer_find_iface(CURL *handle)
+{
+	int	i;
+
+	for (i = 0; i < writer.ifaces.values_num; i++)
+	{
+		zbx_history_iface_t	*hist = (zbx_history_iface_t *)writer.ifaces.values[i];
+
+		if (((zbx_elastic_data_t *)hist->data.elastic_data)->handle == handle)
+			return hist;
+	}
+
+	return NULL;
+}
+
+/************************************************************************************
+ *                                                                                  *
+ * Purpose: builds bulk request of documents that must be sent again, without the   *
+ *          documents that were indexed or permanently rejected                     *
+ *                                                                                  *
+ * Parameters: data - [IN] the elastic data with bulk request                       *
+ *             page - [IN] the bulk response                                        *
+ *             buf  - [OUT] the documents to send again                             *
+ *                                                                                  *
+ * Return value: The number of documents left for retry or FAIL if response items   *
+ *               cannot be matched with request documents.                          *
+ *                                                                                  *
+ * Comments: Bulk response items are returned in the same order as request          *
+ *           documents, each document consists of action and source lines.          *
+ *           Documents rejected because of full queues (status 429) or server       *
+ *           errors are retried, documents rejected for other reasons (for example  *
+ *           mapping errors) will never be accepted and are dropped.                *
+ *                                                                                  *
+ ************************************************************************************/
+static int	elastic_writer_filter_docs(const zbx_elastic_data_t *data, const zbx_httppage_t *page, char **buf)
+{
+	struct zbx_json_parse	jp, jp_items, jp_item, jp_action, jp_error;
+	const char		*p = NULL, *doc = data->buf, *next;
+	char			status[MAX_ID_LEN + 1];
+	size_t			buf_alloc = 0, buf_offset = 0;
+	int			retry_num = 0, dropped_num = 0, code;
+
+	if (SUCCEED != zbx_json_open(page->data, &jp) || SUCCEED != zbx_json_brackets_by_name(&jp, "items", &jp_items))
+		return FAIL;
+
+	while (NULL != (p = zbx_json_next(&jp_items, p)))
+	{
+		if (NULL == (next = strchr(doc, '\n')) || NULL == (next = strchr(next + 1, '\n')))
+			goto fail;
+
+		next++;
+
+		if (SUCCEED == zbx_json_brackets_open(p, &jp_item) &&
+				SUCCEED == zbx_json_brackets_by_name(&jp_item, "index", &jp_action) &&
+				SUCCEED == zbx_json_brackets_by_name(&jp_action, "error", &jp_error))
+		{
+			if (SUCCEED == zbx_json_value_by_name(&jp_action, "status", status, sizeof(status), NULL) &&
+					SUCCEED == zbx_is_uint31(status, &code) && 429 != code && 500 > code)
+			{
+				dropped_num++;
+			}
+			else
+			{
+				zbx_strncpy_alloc(buf, &buf_alloc, &buf_offset, doc, (size_t)(next - doc));
+				retry_num++;
+			}
+		}
+
+		doc = next;
+	}
+
+	/* all request documents must have response items */
+	if ('\0' != *doc)
+		goto fail;
+
+	if (0 != dropped_num)
+		zabbix_log(LOG_LEVEL_WARNING, "%d history values were rejected by elasticsearch", dropped_num);
+
+	return retry_num;
+fail:
+	zbx_free(*buf);
+
+	return FAIL;
+}
+
 /************************************************************************************
  *                                                                                  *
  * Purpose: posts historical data to elastic storage                                *
@@ -476,10 +566,11 @@ try_again:
 
 	do
 	{
-		int		fds;
-		CURLMcode	code;
-		char		*error;
-		zbx_curlpage_t	*curl_page;
+		int			fds, retry_num;
+		CURLMcode		code;
+		char			*error;
+		zbx_curlpage_t		*curl_page;
+		zbx_history_iface_t	*hist;
 
 		if (CURLM_OK != (code = curl_multi_perform(writer.handle, &running)))
 		{
@@ -555,9 +646,43 @@ try_again:
 						__func__, error);
 				zbx_free(error);
 
+				/* Only the rejected documents are sent again, resending the whole */
+				/* batch would duplicate the documents that were already indexed.  */
+				if (NULL != (hist = elastic_writer_find_iface(msg->easy_handle)))
+				{
+					zbx_elastic_data_t	*data = (zbx_elastic_data_t *)hist->data.elastic_data;
+					char			*buf = NULL;
+
+					if (0 == (retry_num = elastic_writer_filter_docs(data, &curl_page->page, &buf)))
+						continue;
+
+					if (FAIL != retry_num)
+					{
+						/* the previous request data is kept until the handle is updated, */
+						/* otherwise the whole batch is sent again                        */
+						if (CURLE_OK != (err = curl_easy_setopt(msg->easy_handle,
+								CURLOPT_POSTFIELDS, buf)))
+						{
+							zabbix_log(LOG_LEVEL_ERR, "cannot set cURL option %d: [%s],"
+									" sending all documents again",
+									(int)CURLOPT_POSTFIELDS,
+									curl_easy_strerror(err));
+							zbx_free(buf);
+						}
+						else
+						{
+							zbx_free(data->buf);
+							data->buf = buf;
+						}
+					}
+				}
+
 				/* If the error is due to elastic internal problems (for example an index */
 				/* became read-only), we put the handle in a retry list and */
 				/* remove it from the current execution loop */
+				curl_page->page.offset = 0;
+				*curl_page->page.data = '\0';
+
 				zbx_vector_ptr_append(&retries, msg->easy_handle);
 				curl_multi_remove_handle(writer.handle, msg->easy_handle);
 			}
@@ -1013,6 +1138,7 @@ int	zbx_history_elastic_init(zbx_history_iface_t *hist, unsigned char value_type
 	hist->add_values = elastic_add_values;
 	hist->flush = elastic_flush;
 	hist->get_values = elastic_get_values;
+	hist->get_items_values = NULL;
 	hist->requires_trends = 0;
 
 	return SUCCEED;
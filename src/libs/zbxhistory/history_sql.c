@@ -639,6 +639,67 @@ static int	sql_get_values(zbx_history_iface_t *hist, zbx_uint64_t itemid, int st
 	return db_read_values_by_time_and_count(itemid, hist->value_type, values, end - start, count, end);
 }
 
+/************************************************************************************
+ *                                                                                  *
+ * Purpose: gets history data of multiple items from history storage                *
+ *                                                                                  *
+ * Parameters:  hist        - [IN] the history storage interface                    *
+ *              itemids     - [IN] the itemids                                      *
+ *              itemids_num - [IN] the number of itemids                            *
+ *              start       - [IN] the period start timestamp                       *
+ *              end         - [IN] the period end timestamp                         *
+ *              values      - [OUT] the items history data values                   *
+ *                                                                                  *
+ * Return value: SUCCEED - the history data were read successfully                  *
+ *               FAIL - otherwise                                                   *
+ *                                                                                  *
+ * Comments: This function reads all values from ]<start>,<end>] interval with      *
+ *           single query.                                                          *
+ *                                                                                  *
+ ************************************************************************************/
+static int	sql_get_items_values(zbx_history_iface_t *hist, const zbx_uint64_t *itemids, int itemids_num,
+		int start, int end, zbx_vector_history_item_record_t *values)
+{
+	char			*sql = NULL;
+	size_t			sql_alloc = 0, sql_offset = 0;
+	zbx_db_result_t		result;
+	zbx_db_row_t		row;
+	zbx_vc_history_table_t	*table = &vc_history_tables[hist->value_type];
+	time_t			time_from = start;
+
+	zbx_recalc_time_period(&time_from, ZBX_RECALC_TIME_PERIOD_HISTORY);
+
+	zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset,
+			"select itemid,clock,ns,%s"
+			" from %s"
+			" where clock>" ZBX_FS_I64 " and clock<=%d and",
+			table->fields, table->name, time_from, end);
+
+	zbx_db_add_condition_alloc(&sql, &sql_alloc, &sql_offset, "itemid", itemids, itemids_num);
+
+	result = zbx_db_select("%s", sql);
+
+	zbx_free(sql);
+
+	if (NULL == result)
+		return FAIL;
+
+	while (NULL != (row = zbx_db_fetch(result)))
+	{
+		zbx_history_item_record_t	value;
+
+		ZBX_STR2UINT64(value.itemid, row[0]);
+		value.record.timestamp.sec = atoi(row[1]);
+		value.record.timestamp.ns = atoi(row[2]);
+		table->rtov(&value.record.value, row + 3);
+
+		zbx_vector_history_item_record_append_ptr(values, &value);
+	}
+	zbx_db_free_result(result);
+
+	return SUCCEED;
+}
+
 /**********************************************************************************************
  *                                                                                            *
  * Purpose: sends history data to storage                                                     *
@@ -703,6 +764,7 @@ void	zbx_history_sql_init(zbx_history_iface_t *hist, unsigned char value_type)
 	hist->add_values = sql_add_values;
 	hist->flush = sql_flush;
 	hist->get_values = sql_get_values;
+	hist->get_items_values = sql_get_items_values;
 
 	switch (value_type)
 	{
@@ -520,10 +520,26 @@ static void	__mem_free(zbx_shmem_info_t *info, void *ptr)
 
 /* public memory interface */
 
+static int	shmem_huge_pages = 0;
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: sets whether shared memory segments created afterwards should be  *
+ *          backed by huge pages                                              *
+ *                                                                            *
+ * Parameters: huge_pages - [IN] 1 - try huge pages first, 0 - default pages  *
+ *                                                                            *
+ ******************************************************************************/
+void	zbx_shmem_set_huge_pages(int huge_pages)
+{
+	shmem_huge_pages = huge_pages;
+}
+
 int	zbx_shmem_create(zbx_shmem_info_t **info, zbx_uint64_t size, const char *descr, const char *param,
 		int allow_oom, char **error)
 {
-	int	shm_id, index, ret = FAIL;
+	int	shm_id = -1, index, ret = FAIL;
+	char	huge_pages = 0;
 	void	*base;
 
 	descr = ZBX_NULL2STR(descr);
@@ -547,7 +563,21 @@ int	zbx_shmem_create(zbx_shmem_info_t **info, zbx_uint64_t size, const char *des
 		goto out;
 	}
 
-	if (-1 == (shm_id = shmget(IPC_PRIVATE, size, 0600)))
+#ifdef SHM_HUGETLB
+	/* segment size is rounded up to huge page size by kernel */
+	if (0 != shmem_huge_pages)
+	{
+		if (-1 == (shm_id = shmget(IPC_PRIVATE, size, 0600 | SHM_HUGETLB)))
+		{
+			zabbix_log(LOG_LEVEL_WARNING, "cannot get huge page backed shared memory of size "
+					ZBX_FS_SIZE_T " for %s, falling back to default pages: %s",
+					(zbx_fs_size_t)size, descr, zbx_strerror(errno));
+		}
+		else
+			huge_pages = 1;
+	}
+#endif
+	if (-1 == shm_id && -1 == (shm_id = shmget(IPC_PRIVATE, size, 0600)))
 	{
 		*error = zbx_dsprintf(*error, "cannot get private shared memory of size " ZBX_FS_SIZE_T " for %s: %s",
 				(zbx_fs_size_t)size, descr, zbx_strerror(errno));
@@ -591,6 +621,7 @@ int	zbx_shmem_create(zbx_shmem_info_t **info, zbx_uint64_t size, const char *des
 	base = (void *)((char *)base + strlen(param) + 1);
 
 	(*info)->allow_oom = allow_oom;
+	(*info)->huge_pages = huge_pages;
 
 	/* prepare shared memory for further allocation by creating one big chunk */
 	(*info)->lo_bound = ALIGN8(base);
@@ -795,6 +826,7 @@ void	zbx_shmem_get_stats(const zbx_shmem_info_t *info, zbx_shmem_stats_t *stats)
 	stats->used_chunks = stats->overhead / (2 * SHMEM_SIZE_FIELD) + 1 - stats->free_chunks;
 	stats->free_size = info->free_size;
 	stats->used_size = info->used_size;
+	stats->huge_pages = (unsigned char)info->huge_pages;
 }
 
 void	zbx_shmem_dump_stats(int level, zbx_shmem_info_t *info)
@@ -82,26 +82,53 @@ static int	queue_directory(zbx_vector_ptr_t *list, char *path, int depth, int ma
 	return FAIL;	/* 'path' did not go into 'list' - don't forget to free 'path' in the caller */
 }
 
+static zbx_hash_t	descriptor_hash(const void *data)
+{
+	const zbx_file_descriptor_t	*file = (const zbx_file_descriptor_t *)data;
+	zbx_hash_t			hash;
+
+	hash = ZBX_DEFAULT_UINT64_HASH_ALGO(&file->st_ino, sizeof(file->st_ino), ZBX_DEFAULT_HASH_SEED);
+
+	return ZBX_DEFAULT_UINT64_HASH_ALGO(&file->st_dev, sizeof(file->st_dev), hash);
+}
+
+static int	descriptor_compare(const void *d1, const void *d2)
+{
+	const zbx_file_descriptor_t	*fa = (const zbx_file_descriptor_t *)d1;
+	const zbx_file_descriptor_t	*fb = (const zbx_file_descriptor_t *)d2;
+
+	ZBX_RETURN_IF_NOT_EQUAL(fa->st_ino, fb->st_ino);
+	ZBX_RETURN_IF_NOT_EQUAL(fa->st_dev, fb->st_dev);
+
+	return 0;
+}
+
 /******************************************************************************
  *                                                                            *
- * Purpose: Compares two zbx_file_descriptor_t values to perform search       *
- *          within descriptor vector.                                         *
+ * Purpose: checks if file with multiple hardlinks was already processed and  *
+ *          remembers it otherwise                                            *
  *                                                                            *
- * Parameters: file_a - [IN] file descriptor A                                *
- *             file_b - [IN] file descriptor B                                *
+ * Parameters: descriptors - [IN/OUT] processed file descriptors              *
+ *             st_dev      - [IN] device                                      *
+ *             st_ino      - [IN] file serial number                          *
  *                                                                            *
- * Return value: If file descriptor values are the same, 0 is returned        *
- *               otherwise nonzero value is returned.                         *
+ * Return value: SUCCEED - file was already processed                         *
+ *               FAIL    - file is seen for the first time                    *
  *                                                                            *
  ******************************************************************************/
-static int	compare_descriptors(const void *file_a, const void *file_b)
+static int	descriptor_processed(zbx_hashset_t *descriptors, zbx_uint64_t st_dev, zbx_uint64_t st_ino)
 {
-	const zbx_file_descriptor_t	*fa, *fb;
+	zbx_file_descriptor_t	file;
+
+	file.st_dev = st_dev;
+	file.st_ino = st_ino;
+
+	if (NULL != zbx_hashset_search(descriptors, &file))
+		return SUCCEED;
 
-	fa = *((zbx_file_descriptor_t * const *)file_a);
-	fb = *((zbx_file_descriptor_t * const *)file_b);
+	zbx_hashset_insert(descriptors, &file, sizeof(file));
 
-	return (fa->st_ino != fb->st_ino || fa->st_dev != fb->st_dev);
+	return FAIL;
 }
 
 static int	prepare_common_parameters(const AGENT_REQUEST *request, AGENT_RESULT *result, zbx_regexp_t **regex_incl,
@@ -376,18 +403,6 @@ static void	list_vector_destroy(zbx_vector_ptr_t *list)
 	zbx_vector_ptr_destroy(list);
 }
 
-static void	descriptors_vector_destroy(zbx_vector_ptr_t *descriptors)
-{
-	zbx_file_descriptor_t	*file;
-
-	while (0 < descriptors->values_num)
-	{
-		file = (zbx_file_descriptor_t *)descriptors->values[--descriptors->values_num];
-		zbx_free(file);
-	}
-	zbx_vector_ptr_destroy(descriptors);
-}
-
 /******************************************************************************
  *                                                                            *
  * Different approach is used for Windows implementation as Windows is not    *
@@ -459,10 +474,9 @@ static int	get_file_info_by_handle(wchar_t *wpath, BY_HANDLE_FILE_INFORMATION *l
 	return SUCCEED;
 }
 
-static int	link_processed(DWORD attrib, wchar_t *wpath, zbx_vector_ptr_t *descriptors, char *path)
+static int	link_processed(DWORD attrib, wchar_t *wpath, zbx_hashset_t *descriptors, char *path)
 {
 	BY_HANDLE_FILE_INFORMATION	link_info;
-	zbx_file_descriptor_t		*file;
 	char 				*error;
 
 	/* Behavior like MS file explorer */
@@ -480,21 +494,11 @@ static int	link_processed(DWORD attrib, wchar_t *wpath, zbx_vector_ptr_t *descri
 	}
 
 	/* A file is a hard link only */
-	if (1 < link_info.nNumberOfLinks)
+	/* skip file if inode was already processed (multiple hardlinks) */
+	if (1 < link_info.nNumberOfLinks && SUCCEED == descriptor_processed(descriptors,
+			link_info.dwVolumeSerialNumber, DW2UI64(link_info.nFileIndexHigh, link_info.nFileIndexLow)))
 	{
-		/* skip file if inode was already processed (multiple hardlinks) */
-		file = (zbx_file_descriptor_t*)zbx_malloc(NULL, sizeof(zbx_file_descriptor_t));
-
-		file->st_dev = link_info.dwVolumeSerialNumber;
-		file->st_ino = DW2UI64(link_info.nFileIndexHigh, link_info.nFileIndexLow);
-
-		if (FAIL != zbx_vector_ptr_search(descriptors, file, compare_descriptors))
-		{
-			zbx_free(file);
-			return SUCCEED;
-		}
-
-		zbx_vector_ptr_append(descriptors, file);
+		return SUCCEED;
 	}
 
 	return FAIL;
@@ -505,7 +509,8 @@ static int	vfs_dir_size_local(AGENT_REQUEST *request, AGENT_RESULT *result, HAND
 	char			*dir = NULL;
 	int			mode, max_depth, ret = SYSINFO_RET_FAIL;
 	zbx_uint64_t		size = 0;
-	zbx_vector_ptr_t	list, descriptors;
+	zbx_vector_ptr_t	list;
+	zbx_hashset_t		descriptors;
 	zbx_stat_t		status;
 	zbx_regexp_t		*regex_incl = NULL, *regex_excl = NULL, *regex_excl_dir = NULL;
 	size_t			dir_len;
@@ -519,7 +524,7 @@ static int	vfs_dir_size_local(AGENT_REQUEST *request, AGENT_RESULT *result, HAND
 		goto err1;
 	}
 
-	zbx_vector_ptr_create(&descriptors);
+	zbx_hashset_create(&descriptors, 0, descriptor_hash, descriptor_compare);
 	zbx_vector_ptr_create(&list);
 
 	dir_len = strlen(dir);	/* store this value before giving away pointer ownership */
@@ -670,19 +675,49 @@ skip:
 	ret = SYSINFO_RET_OK;
 err2:
 	list_vector_destroy(&list);
-	descriptors_vector_destroy(&descriptors);
+	zbx_hashset_destroy(&descriptors);
 err1:
 	regex_incl_excl_free(regex_incl, regex_excl, regex_excl_dir);
 
 	return ret;
 }
 #else /* not _WINDOWS or __MINGW32__ */
+/******************************************************************************
+ *                                                                            *
+ * Purpose: gets status of directory entry without following symbolic links   *
+ *                                                                            *
+ * Parameters: directory - [IN] open directory containing the entry           *
+ *             name      - [IN] entry name relative to the directory          *
+ *             path      - [IN] full entry path                               *
+ *             status    - [OUT]                                              *
+ *                                                                            *
+ * Return value: 0 on success, -1 on error (errno is set)                     *
+ *                                                                            *
+ * Comments: Looking up the name relative to the already open directory       *
+ *           avoids resolving the full path for every entry.                  *
+ *                                                                            *
+ ******************************************************************************/
+static int	dir_entry_lstat(DIR *directory, const char *name, const char *path, zbx_stat_t *status)
+{
+#if defined(HAVE_FSTATAT) && defined(HAVE_DIRFD)
+	ZBX_UNUSED(path);
+
+	return fstatat(dirfd(directory), name, status, AT_SYMLINK_NOFOLLOW);
+#else
+	ZBX_UNUSED(directory);
+	ZBX_UNUSED(name);
+
+	return lstat(path, status);
+#endif
+}
+
 static int	vfs_dir_size_local(AGENT_REQUEST *request, AGENT_RESULT *result)
 {
 	char			*dir = NULL;
 	int			mode, max_depth, ret = SYSINFO_RET_FAIL;
 	zbx_uint64_t		size = 0;
-	zbx_vector_ptr_t	list, descriptors;
+	zbx_vector_ptr_t	list;
+	zbx_hashset_t		descriptors;
 	zbx_stat_t		status;
 	zbx_regexp_t		*regex_incl = NULL, *regex_excl = NULL, *regex_excl_dir = NULL;
 	size_t			dir_len;
@@ -696,7 +731,7 @@ static int	vfs_dir_size_local(AGENT_REQUEST *request, AGENT_RESULT *result)
 		goto err1;
 	}
 
-	zbx_vector_ptr_create(&descriptors);
+	zbx_hashset_create(&descriptors, 0, descriptor_hash, descriptor_compare);
 	zbx_vector_ptr_create(&list);
 
 	dir_len = strlen(dir);	/* store this value before giving away pointer ownership */
@@ -750,7 +785,7 @@ static int	vfs_dir_size_local(AGENT_REQUEST *request, AGENT_RESULT *result)
 
 			path = zbx_dsprintf(NULL, "%s/%s", item->path, entry->d_name);
 
-			if (0 == lstat(path, &status))
+			if (0 == dir_entry_lstat(directory, entry->d_name, path, &status))
 			{
 				if (NULL != regex_excl_dir && 0 != S_ISDIR(status.st_mode))
 				{
@@ -766,26 +801,13 @@ static int	vfs_dir_size_local(AGENT_REQUEST *request, AGENT_RESULT *result)
 						0 != S_ISDIR(status.st_mode)) &&
 						0 != filename_matches(entry->d_name, regex_incl, regex_excl))
 				{
-					if (0 != S_ISREG(status.st_mode) && 1 < status.st_nlink)
+					/* skip file if inode was already processed (multiple hardlinks) */
+					if (0 != S_ISREG(status.st_mode) && 1 < status.st_nlink &&
+							SUCCEED == descriptor_processed(&descriptors,
+							(zbx_uint64_t)status.st_dev, (zbx_uint64_t)status.st_ino))
 					{
-						zbx_file_descriptor_t	*file;
-
-						/* skip file if inode was already processed (multiple hardlinks) */
-						file = (zbx_file_descriptor_t*)zbx_malloc(NULL,
-								sizeof(zbx_file_descriptor_t));
-
-						file->st_dev = status.st_dev;
-						file->st_ino = status.st_ino;
-
-						if (FAIL != zbx_vector_ptr_search(&descriptors, file,
-								compare_descriptors))
-						{
-							zbx_free(file);
-							zbx_free(path);
-							continue;
-						}
-
-						zbx_vector_ptr_append(&descriptors, file);
+						zbx_free(path);
+						continue;
 					}
 
 					if (SIZE_MODE_APPARENT == mode)
@@ -818,7 +840,7 @@ skip:
 	ret = SYSINFO_RET_OK;
 err2:
 	list_vector_destroy(&list);
-	descriptors_vector_destroy(&descriptors);
+	zbx_hashset_destroy(&descriptors);
 err1:
 	regex_incl_excl_free(regex_incl, regex_excl, regex_excl_dir);
 
@@ -864,7 +886,8 @@ static int	vfs_dir_info(AGENT_REQUEST *request, AGENT_RESULT *result, HANDLE tim
 	char			*dir = NULL;
 	int			types, max_depth, ret = SYSINFO_RET_FAIL;
 	zbx_uint64_t		count = 0;
-	zbx_vector_ptr_t	list, descriptors;
+	zbx_vector_ptr_t	list;
+	zbx_hashset_t		descriptors;
 	zbx_stat_t		status;
 	zbx_regexp_t		*regex_incl = NULL, *regex_excl = NULL, *regex_excl_dir = NULL;
 	zbx_uint64_t		min_size = 0, max_size = __UINT64_C(0x7fffffffffffffff);
@@ -882,7 +905,7 @@ static int	vfs_dir_info(AGENT_REQUEST *request, AGENT_RESULT *result, HANDLE tim
 	}
 
 	zbx_json_initarray(&j, ZBX_JSON_STAT_BUF_LEN);
-	zbx_vector_ptr_create(&descriptors);
+	zbx_hashset_create(&descriptors, 0, descriptor_hash, descriptor_compare);
 	zbx_vector_ptr_create(&list);
 
 	dir_len = strlen(dir);	/* store this value before giving away pointer ownership */
@@ -1028,7 +1051,7 @@ skip:
 	ret = SYSINFO_RET_OK;
 err2:
 	list_vector_destroy(&list);
-	descriptors_vector_destroy(&descriptors);
+	zbx_hashset_destroy(&descriptors);
 	zbx_json_free(&j);
 err1:
 	regex_incl_excl_free(regex_incl, regex_excl, regex_excl_dir);
@@ -1113,7 +1136,7 @@ static int	vfs_dir_info(AGENT_REQUEST *request, AGENT_RESULT *result, int count_
 			else
 				path = zbx_dsprintf(NULL, "%s/%s", item->path, entry->d_name);
 
-			if (0 == lstat(path, &status))
+			if (0 == dir_entry_lstat(directory, entry->d_name, path, &status))
 			{
 				if (NULL != regex_excl_dir && 0 != S_ISDIR(status.st_mode))
 				{
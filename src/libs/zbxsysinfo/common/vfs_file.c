@@ -26,6 +26,10 @@
 #include "zbxfile.h"
 #include "zbxjson.h"
 
+#if defined(HAVE_MINCORE)
+#	include <sys/mman.h>
+#endif
+
 #if defined(_WINDOWS) || defined(__MINGW32__)
 #include "aclapi.h"
 #include "sddl.h"
@@ -724,6 +728,199 @@ err:
 	return ret;
 }
 
+#define ZBX_CKSUM_CACHE_RELEASE_SIZE	(8 * ZBX_MEBIBYTE)
+#define ZBX_CKSUM_CACHE_TRACK_SIZE	(__UINT64_C(64) * ZBX_GIBIBYTE)
+
+typedef struct
+{
+	int		fd;
+	int		release;
+	zbx_uint64_t	released;
+#if defined(HAVE_MINCORE)
+	zbx_uint64_t	page_size;
+	zbx_uint64_t	pages_num;
+	unsigned char	*resident;
+#endif
+}
+cksum_cache_t;
+
+#if defined(HAVE_MINCORE)
+/******************************************************************************
+ *                                                                            *
+ * Purpose: remembers which pages of file are in page cache before the file   *
+ *          is read                                                           *
+ *                                                                            *
+ * Parameters: cache - [IN/OUT]                                               *
+ *                                                                            *
+ * Comments: Residency is taken for the whole file at once, because           *
+ *           readahead brings pages in long before they are checksummed.      *
+ *           Pages with unknown residency are treated as resident and are     *
+ *           left in page cache.                                              *
+ *                                                                            *
+ ******************************************************************************/
+static void	cksum_cache_get_residency(cksum_cache_t *cache)
+{
+	unsigned char	vec[ZBX_CKSUM_CACHE_RELEASE_SIZE / ZBX_KIBIBYTE];
+	zbx_uint64_t	offset, i, page = 0, window_pages = ZBX_CKSUM_CACHE_RELEASE_SIZE / cache->page_size;
+	void		*addr;
+
+	cache->resident = (unsigned char *)zbx_calloc(NULL, (size_t)(cache->pages_num + 7) / 8, 1);
+
+	for (offset = 0; page < cache->pages_num; offset += ZBX_CKSUM_CACHE_RELEASE_SIZE)
+	{
+		if (MAP_FAILED == (addr = mmap(NULL, ZBX_CKSUM_CACHE_RELEASE_SIZE, PROT_READ, MAP_SHARED,
+				cache->fd, (off_t)offset)))
+		{
+			memset(vec, 1, sizeof(vec));
+		}
+		else
+		{
+			if (0 != mincore(addr, ZBX_CKSUM_CACHE_RELEASE_SIZE, (void *)vec))
+				memset(vec, 1, sizeof(vec));
+
+			munmap(addr, ZBX_CKSUM_CACHE_RELEASE_SIZE);
+		}
+
+		for (i = 0; i < window_pages && page < cache->pages_num; i++, page++)
+		{
+			if (0 != (vec[i] & 1))
+				cache->resident[page >> 3] |= (unsigned char)(1 << (page & 7));
+		}
+	}
+}
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: prepares reading of file to be checksummed                        *
+ *                                                                            *
+ * Parameters: cache - [OUT]                                                  *
+ *             f     - [IN] file descriptor                                   *
+ *                                                                            *
+ * Comments: Pages are dropped from page cache only for regular files of at   *
+ *           least ZBX_CKSUM_CACHE_RELEASE_SIZE bytes, so that checksumming   *
+ *           large files (for example database dumps) does not evict pages    *
+ *           other processes are using. Small files are left alone.           *
+ *                                                                            *
+ ******************************************************************************/
+static void	cksum_cache_init(cksum_cache_t *cache, int f)
+{
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_DONTNEED)
+	zbx_stat_t	st;
+#endif
+#if defined(HAVE_MINCORE)
+	long		page_size;
+
+	cache->resident = NULL;
+#endif
+	cache->fd = f;
+	cache->release = 0;
+	cache->released = 0;
+
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_SEQUENTIAL)
+	(void)posix_fadvise(f, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_DONTNEED)
+	if (0 != zbx_fstat(f, &st) || 0 == S_ISREG(st.st_mode) || ZBX_CKSUM_CACHE_RELEASE_SIZE > st.st_size)
+		return;
+#if defined(HAVE_MINCORE)
+	if (0 >= (page_size = sysconf(_SC_PAGESIZE)) || ZBX_KIBIBYTE > page_size ||
+			0 != ZBX_CKSUM_CACHE_RELEASE_SIZE % page_size)
+	{
+		return;
+	}
+
+	/* pages beyond tracked size are never dropped */
+	cache->page_size = (zbx_uint64_t)page_size;
+	cache->pages_num = (MIN((zbx_uint64_t)st.st_size, ZBX_CKSUM_CACHE_TRACK_SIZE) + cache->page_size - 1) /
+			cache->page_size;
+	cksum_cache_get_residency(cache);
+#endif
+	cache->release = 1;
+#endif
+}
+
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_DONTNEED)
+/******************************************************************************
+ *                                                                            *
+ * Purpose: drops pages of released window that were not in page cache        *
+ *          before they were read                                             *
+ *                                                                            *
+ * Parameters: cache - [IN]                                                   *
+ *             size  - [IN] number of bytes to release after the already      *
+ *                          released part of file                             *
+ *                                                                            *
+ ******************************************************************************/
+static void	cksum_cache_release_window(const cksum_cache_t *cache, zbx_uint64_t size)
+{
+#if defined(HAVE_MINCORE)
+	zbx_uint64_t	page, start, last;
+
+	page = cache->released / cache->page_size;
+	last = MIN((cache->released + size + cache->page_size - 1) / cache->page_size, cache->pages_num);
+
+	while (page < last)
+	{
+		while (page < last && 0 != (cache->resident[page >> 3] & (1 << (page & 7))))
+			page++;
+
+		for (start = page; page < last && 0 == (cache->resident[page >> 3] & (1 << (page & 7))); page++)
+			;
+
+		if (start != page)
+		{
+			(void)posix_fadvise(cache->fd, (off_t)(start * cache->page_size),
+					(off_t)((page - start) * cache->page_size), POSIX_FADV_DONTNEED);
+		}
+	}
+#else
+	(void)posix_fadvise(cache->fd, (off_t)cache->released, (off_t)size, POSIX_FADV_DONTNEED);
+#endif
+}
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: drops already checksummed part of large file from page cache      *
+ *                                                                            *
+ * Parameters: cache     - [IN/OUT]                                           *
+ *             processed - [IN] number of bytes processed so far              *
+ *             finish    - [IN] release also the last incomplete window       *
+ *                                                                            *
+ ******************************************************************************/
+static void	cksum_cache_release(cksum_cache_t *cache, zbx_uint64_t processed, int finish)
+{
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_DONTNEED)
+	if (0 == cache->release)
+		return;
+
+	while (ZBX_CKSUM_CACHE_RELEASE_SIZE <= processed - cache->released)
+	{
+		cksum_cache_release_window(cache, ZBX_CKSUM_CACHE_RELEASE_SIZE);
+		cache->released += ZBX_CKSUM_CACHE_RELEASE_SIZE;
+	}
+
+	if (0 != finish && processed != cache->released)
+	{
+		cksum_cache_release_window(cache, processed - cache->released);
+		cache->released = processed;
+	}
+#else
+	ZBX_UNUSED(cache);
+	ZBX_UNUSED(processed);
+	ZBX_UNUSED(finish);
+#endif
+}
+
+static void	cksum_cache_destroy(cksum_cache_t *cache)
+{
+#if defined(HAVE_MINCORE)
+	zbx_free(cache->resident);
+#else
+	ZBX_UNUSED(cache);
+#endif
+}
+
 static int	vfs_file_cksum_md5(char *filename, AGENT_RESULT *result)
 {
 	int		nbytes, f, ret = SYSINFO_RET_FAIL;
@@ -733,6 +930,8 @@ static int	vfs_file_cksum_md5(char *filename, AGENT_RESULT *result)
 	size_t		sz;
 	md5_byte_t	hash[ZBX_MD5_DIGEST_SIZE];
 	double		ts = zbx_time();
+	zbx_uint64_t	processed = 0;
+	cksum_cache_t	cache;
 
 	if (-1 == (f = zbx_open(filename, O_RDONLY)))
 	{
@@ -740,6 +939,8 @@ static int	vfs_file_cksum_md5(char *filename, AGENT_RESULT *result)
 		goto err;
 	}
 
+	cksum_cache_init(&cache, f);
+
 	if (sysinfo_get_config_timeout() < zbx_time() - ts)
 	{
 		SET_MSG_RESULT(result, zbx_strdup(NULL, "Timeout while processing item."));
@@ -757,6 +958,9 @@ static int	vfs_file_cksum_md5(char *filename, AGENT_RESULT *result)
 		}
 
 		zbx_md5_append(&state, (const md5_byte_t *)buf, nbytes);
+
+		processed += (zbx_uint64_t)nbytes;
+		cksum_cache_release(&cache, processed, 0);
 	}
 
 	zbx_md5_finish(&state, hash);
@@ -780,7 +984,11 @@ static int	vfs_file_cksum_md5(char *filename, AGENT_RESULT *result)
 	ret = SYSINFO_RET_OK;
 err:
 	if (-1 != f)
+	{
+		cksum_cache_release(&cache, processed, 1);
+		cksum_cache_destroy(&cache);
 		close(f);
+	}
 
 	return ret;
 }
@@ -862,13 +1070,38 @@ static u_long	crctab[] =
 	0xa2f33668, 0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
 };
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: builds lookup tables for processing four bytes per step           *
+ *          ("slicing-by-4") from the byte-wise crctab                        *
+ *                                                                            *
+ * Parameters: tab - [OUT] tab[0] is crctab, tab[n] is crctab advanced by n   *
+ *                         zero bytes                                         *
+ *                                                                            *
+ ******************************************************************************/
+static void	crc32_init_slices(zbx_uint32_t tab[4][256])
+{
+	int	i, n;
+
+	for (i = 0; i < 256; i++)
+		tab[0][i] = (zbx_uint32_t)crctab[i];
+
+	for (n = 1; n < 4; n++)
+	{
+		for (i = 0; i < 256; i++)
+			tab[n][i] = (tab[n - 1][i] << 8) ^ tab[0][tab[n - 1][i] >> 24];
+	}
+}
+
 static int	vfs_file_cksum_crc32(char *filename, AGENT_RESULT *result)
 {
 	int		i, nr, f, ret = SYSINFO_RET_FAIL;
-	zbx_uint32_t	crc, flen;
+	zbx_uint32_t	crc, flen, tab[4][256];
 	u_char		buf[16 * ZBX_KIBIBYTE];
 	u_long		cval;
 	double		ts;
+	zbx_uint64_t	processed = 0;
+	cksum_cache_t	cache;
 
 	ts = zbx_time();
 
@@ -878,12 +1111,16 @@ static int	vfs_file_cksum_crc32(char *filename, AGENT_RESULT *result)
 		goto err;
 	}
 
+	cksum_cache_init(&cache, f);
+
 	if (sysinfo_get_config_timeout() < zbx_time() - ts)
 	{
 		SET_MSG_RESULT(result, zbx_strdup(NULL, "Timeout while processing item."));
 		goto err;
 	}
 
+	crc32_init_slices(tab);
+
 	crc = flen = 0;
 
 	while (0 < (nr = (int)read(f, buf, sizeof(buf))))
@@ -896,8 +1133,20 @@ static int	vfs_file_cksum_crc32(char *filename, AGENT_RESULT *result)
 
 		flen += nr;
 
-		for (i = 0; i < nr; i++)
-			crc = (crc << 8) ^ crctab[((crc >> 24) ^ buf[i]) & 0xff];
+		for (i = 0; i + 4 <= nr; i += 4)
+		{
+			crc ^= (zbx_uint32_t)buf[i] << 24 | (zbx_uint32_t)buf[i + 1] << 16 |
+					(zbx_uint32_t)buf[i + 2] << 8 | (zbx_uint32_t)buf[i + 3];
+
+			crc = tab[3][crc >> 24] ^ tab[2][(crc >> 16) & 0xff] ^ tab[1][(crc >> 8) & 0xff] ^
+					tab[0][crc & 0xff];
+		}
+
+		for (; i < nr; i++)
+			crc = (crc << 8) ^ tab[0][((crc >> 24) ^ buf[i]) & 0xff];
+
+		processed += (zbx_uint64_t)nr;
+		cksum_cache_release(&cache, processed, 0);
 	}
 
 	if (0 > nr)
@@ -917,7 +1166,11 @@ static int	vfs_file_cksum_crc32(char *filename, AGENT_RESULT *result)
 	ret = SYSINFO_RET_OK;
 err:
 	if (-1 != f)
+	{
+		cksum_cache_release(&cache, processed, 1);
+		cksum_cache_destroy(&cache);
 		close(f);
+	}
 
 	return ret;
 }
@@ -938,6 +1191,8 @@ static int	vfs_file_cksum_sha256(char *filename, AGENT_RESULT *result)
 	double		ts;
 	ssize_t		nr;
 	sha256_ctx	ctx;
+	zbx_uint64_t	processed = 0;
+	cksum_cache_t	cache;
 
 	ts = zbx_time();
 
@@ -947,6 +1202,8 @@ static int	vfs_file_cksum_sha256(char *filename, AGENT_RESULT *result)
 		goto err;
 	}
 
+	cksum_cache_init(&cache, f);
+
 	if (sysinfo_get_config_timeout() < zbx_time() - ts)
 	{
 		SET_MSG_RESULT(result, zbx_strdup(NULL, "Timeout while processing item."));
@@ -964,6 +1221,9 @@ static int	vfs_file_cksum_sha256(char *filename, AGENT_RESULT *result)
 		}
 
 		zbx_sha256_process_bytes(buf, (size_t)nr, &ctx);
+
+		processed += (zbx_uint64_t)nr;
+		cksum_cache_release(&cache, processed, 0);
 	}
 
 	if (0 > nr)
@@ -990,7 +1250,11 @@ static int	vfs_file_cksum_sha256(char *filename, AGENT_RESULT *result)
 	ret = SYSINFO_RET_OK;
 err:
 	if (-1 != f)
+	{
+		cksum_cache_release(&cache, processed, 1);
+		cksum_cache_destroy(&cache);
 		close(f);
+	}
 
 	return ret;
 }
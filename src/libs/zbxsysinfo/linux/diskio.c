@@ -28,6 +28,11 @@
 
 #if defined(KERNEL_2_4)
 #	define INFO_FILE_NAME	"/proc/partitions"
+#	define PARSE_DEVICE(line)	if (sscanf(line, ZBX_FS_UI64 ZBX_FS_UI64 " %*d %s",	\
+				&rdev_major,							\
+				&rdev_minor,							\
+				name								\
+				) != 3) continue
 #	define PARSE(line)	if (sscanf(line, ZBX_FS_UI64 ZBX_FS_UI64 " %*d %s "		\
 					ZBX_FS_UI64 " %*d " ZBX_FS_UI64 " %*d "			\
 					ZBX_FS_UI64 " %*d " ZBX_FS_UI64 " %*d %*d %*d %*d",	\
@@ -41,6 +46,11 @@
 				) != 7) continue
 #else
 #	define INFO_FILE_NAME	"/proc/diskstats"
+#	define PARSE_DEVICE(line)	if (sscanf(line, ZBX_FS_UI64 ZBX_FS_UI64 " %s",		\
+				&rdev_major,							\
+				&rdev_minor,							\
+				name								\
+				) != 3) continue
 #	define PARSE(line)	if (sscanf(line, ZBX_FS_UI64 ZBX_FS_UI64 " %s "			\
 					ZBX_FS_UI64 " %*d " ZBX_FS_UI64 " %*d "			\
 					ZBX_FS_UI64 " %*d " ZBX_FS_UI64 " %*d %*d %*d %*d",	\
@@ -72,6 +82,7 @@ int	zbx_get_diskstat(const char *devname, zbx_uint64_t *dstat)
 {
 	FILE		*f;
 	char		tmp[MAX_STRING_LEN], name[MAX_STRING_LEN], dev_path[MAX_STRING_LEN];
+	const char	*match = NULL;
 	int		ret = FAIL, dev_exists = FAIL, found = 0;
 	zbx_uint64_t	ds[ZBX_DSTAT_MAX], rdev_major, rdev_minor;
 	zbx_stat_t	dev_st;
@@ -81,6 +92,8 @@ int	zbx_get_diskstat(const char *devname, zbx_uint64_t *dstat)
 
 	if (NULL != devname && '\0' != *devname && 0 != strcmp(devname, "all"))
 	{
+		match = devname;
+
 		*dev_path = '\0';
 		if (0 != strncmp(devname, ZBX_DEV_PFX, ZBX_CONST_STRLEN(ZBX_DEV_PFX)))
 			zbx_strscpy(dev_path, ZBX_DEV_PFX);
@@ -95,21 +108,25 @@ int	zbx_get_diskstat(const char *devname, zbx_uint64_t *dstat)
 
 	while (NULL != fgets(tmp, sizeof(tmp), f))
 	{
-		PARSE(tmp);
-
-		if (NULL != devname && '\0' != *devname && 0 != strcmp(devname, "all"))
+		if (NULL != match)
 		{
-			if (0 != strcmp(name, devname))
+			/* parse counters only for lines of the requested device */
+			PARSE_DEVICE(tmp);
+
+			if (0 != strcmp(name, match))
 			{
 				if (SUCCEED != dev_exists
 					|| major(dev_st.st_rdev) != rdev_major
 					|| minor(dev_st.st_rdev) != rdev_minor)
 					continue;
 			}
-			else
-				found = 1;
 		}
 
+		PARSE(tmp);
+
+		if (NULL != match && 0 == strcmp(name, match))
+			found = 1;
+
 		dstat[ZBX_DSTAT_R_OPER] += ds[ZBX_DSTAT_R_OPER];
 		dstat[ZBX_DSTAT_R_SECT] += ds[ZBX_DSTAT_R_SECT];
 		dstat[ZBX_DSTAT_W_OPER] += ds[ZBX_DSTAT_W_OPER];
@@ -154,10 +171,12 @@ static int	get_kernel_devname(const char *devname, char *kernel_devname, size_t
 
 	while (NULL != fgets(tmp, sizeof(tmp), f))
 	{
-		PARSE(tmp);
+		PARSE_DEVICE(tmp);
 		if (major(dev_st.st_rdev) != rdev_major || minor(dev_st.st_rdev) != rdev_minor)
 			continue;
 
+		PARSE(tmp);
+
 		zbx_strlcpy(kernel_devname, name, max_kernel_devname_len);
 		ret = SUCCEED;
 		break;
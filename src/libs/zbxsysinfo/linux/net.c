@@ -220,6 +220,7 @@ static int	get_net_stat(const char *if_name, net_stat_t *result, char **error)
 	int	ret = SYSINFO_RET_FAIL;
 	char	line[MAX_STRING_LEN], name[MAX_STRING_LEN], *p;
 	FILE	*f;
+	size_t	if_name_len;
 
 	if (NULL == if_name || '\0' == *if_name)
 	{
@@ -233,11 +234,21 @@ static int	get_net_stat(const char *if_name, net_stat_t *result, char **error)
 		return SYSINFO_RET_FAIL;
 	}
 
+	if_name_len = strlen(if_name);
+
 	while (NULL != fgets(line, sizeof(line), f))
 	{
+		char	*start;
+
 		if (NULL == (p = strstr(line, ":")))
 			continue;
 
+		/* parse counters only for the requested interface */
+		start = line + strspn(line, " \t");
+
+		if ((size_t)(p - start) != if_name_len || 0 != strncmp(start, if_name, if_name_len))
+			continue;
+
 		*p = '\t';
 
 		if (17 == sscanf(line, "%s\t" ZBX_FS_UI64 "\t" ZBX_FS_UI64 "\t"
@@ -280,6 +280,35 @@ static int	get_cmdline(FILE *f_cmd, char **line, size_t *line_offset)
 	return FAIL;
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: opens /proc/[pid]/cmdline on first use                            *
+ *                                                                            *
+ * Parameters: pid   - [IN] process id string                                 *
+ *             f_cmd - [IN/OUT] cmdline file, opened if NULL                  *
+ *                                                                            *
+ * Return value: SUCCEED - cmdline file is open                               *
+ *               FAIL    - cannot open cmdline file                           *
+ *                                                                            *
+ * Comments: Most processes are filtered out by status file alone, so the     *
+ *           cmdline file is opened only when a check really needs it.        *
+ *                                                                            *
+ ******************************************************************************/
+static int	open_cmdline(const char *pid, FILE **f_cmd)
+{
+	char	tmp[MAX_STRING_LEN];
+
+	if (NULL != *f_cmd)
+		return SUCCEED;
+
+	zbx_snprintf(tmp, sizeof(tmp), "/proc/%s/cmdline", pid);
+
+	if (NULL == (*f_cmd = fopen(tmp, "r")))
+		return FAIL;
+
+	return SUCCEED;
+}
+
 static int	cmp_status(FILE *f_stat, const char *procname)
 {
 	char	tmp[MAX_STRING_LEN];
@@ -300,7 +329,7 @@ static int	cmp_status(FILE *f_stat, const char *procname)
 	return FAIL;
 }
 
-static int	check_procname(FILE *f_cmd, FILE *f_stat, const char *procname)
+static int	check_procname(const char *pid, FILE **f_cmd, FILE *f_stat, const char *procname)
 {
 	char	*tmp = NULL, *p;
 	size_t	l;
@@ -313,7 +342,7 @@ static int	check_procname(FILE *f_cmd, FILE *f_stat, const char *procname)
 	if (SUCCEED == cmp_status(f_stat, procname))
 		return SUCCEED;
 
-	if (SUCCEED == get_cmdline(f_cmd, &tmp, &l))
+	if (SUCCEED == open_cmdline(pid, f_cmd) && SUCCEED == get_cmdline(*f_cmd, &tmp, &l))
 	{
 		if (NULL == (p = strrchr(tmp, '/')))
 			p = tmp;
@@ -341,7 +370,7 @@ static int	check_user(FILE *f_stat, struct passwd *usrinfo)
 	return FAIL;
 }
 
-static int	check_proccomm(FILE *f_cmd, const zbx_regexp_t *proccomm_rxp)
+static int	check_proccomm(const char *pid, FILE **f_cmd, const zbx_regexp_t *proccomm_rxp)
 {
 	char	*tmp = NULL;
 	size_t	l;
@@ -350,7 +379,7 @@ static int	check_proccomm(FILE *f_cmd, const zbx_regexp_t *proccomm_rxp)
 	if (NULL == proccomm_rxp)
 		return SUCCEED;
 
-	if (SUCCEED == get_cmdline(f_cmd, &tmp, &l))
+	if (SUCCEED == open_cmdline(pid, f_cmd) && SUCCEED == get_cmdline(*f_cmd, &tmp, &l))
 	{
 		l = l - 2;
 
@@ -874,23 +903,22 @@ int	proc_mem(AGENT_REQUEST *request, AGENT_RESULT *result)
 		if (0 == atoi(entries->d_name))
 			continue;
 
-		zbx_snprintf(tmp, sizeof(tmp), "/proc/%s/cmdline", entries->d_name);
-
-		if (NULL == (f_cmd = fopen(tmp, "r")))
-			continue;
-
 		zbx_snprintf(tmp, sizeof(tmp), "/proc/%s/status", entries->d_name);
 
 		if (NULL == (f_stat = fopen(tmp, "r")))
 			continue;
 
-		if (FAIL == check_procname(f_cmd, f_stat, procname))
+		if (FAIL == check_user(f_stat, usrinfo))
 			continue;
 
-		if (FAIL == check_user(f_stat, usrinfo))
+		if (FAIL == check_procname(entries->d_name, &f_cmd, f_stat, procname))
+			continue;
+
+		if (FAIL == check_proccomm(entries->d_name, &f_cmd, proccomm_rxp))
 			continue;
 
-		if (FAIL == check_proccomm(f_cmd, proccomm_rxp))
+		/* processes without readable cmdline are not matched even if it was not needed by checks */
+		if (FAIL == open_cmdline(entries->d_name, &f_cmd))
 			continue;
 
 		rewind(f_stat);
@@ -1162,28 +1190,27 @@ int	proc_num(AGENT_REQUEST *request, AGENT_RESULT *result)
 		if (0 == atoi(entries->d_name))
 			continue;
 
-		zbx_snprintf(tmp, sizeof(tmp), "/proc/%s/cmdline", entries->d_name);
-
-		if (NULL == (f_cmd = fopen(tmp, "r")))
-			continue;
-
 		zbx_snprintf(tmp, sizeof(tmp), "/proc/%s/status", entries->d_name);
 
 		if (NULL == (f_stat = fopen(tmp, "r")))
 			continue;
 
-		if (FAIL == check_procname(f_cmd, f_stat, procname))
+		if (FAIL == check_user(f_stat, usrinfo))
 			continue;
 
-		if (FAIL == check_user(f_stat, usrinfo))
+		if (FAIL == check_procname(entries->d_name, &f_cmd, f_stat, procname))
 			continue;
 
-		if (FAIL == check_proccomm(f_cmd, proccomm_rxp))
+		if (FAIL == check_proccomm(entries->d_name, &f_cmd, proccomm_rxp))
 			continue;
 
 		if (FAIL == check_procstate(f_stat, zbx_proc_stat))
 			continue;
 
+		/* processes without readable cmdline are not matched even if it was not needed by checks */
+		if (FAIL == open_cmdline(entries->d_name, &f_cmd))
+			continue;
+
 		proccount++;
 	}
 	zbx_fclose(f_cmd);
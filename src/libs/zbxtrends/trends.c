@@ -465,73 +465,127 @@ static zbx_trend_state_t	trends_eval(const char *table, zbx_uint64_t itemid, tim
 
 /******************************************************************************
  *                                                                            *
- * Purpose: evaluate avg function with trends data                            *
+ * Purpose: calculate weighted average and sum of trend averages              *
  *                                                                            *
  * Parameters: table       - [IN] trends table name                           *
  *             itemid      - [IN]                                             *
- *             start       - [OUT] period start time in seconds since Epoch   *
- *             end         - [OUT] period end time in seconds since Epoch     *
- *             value       - [OUT] evaluation result                          *
- *                                                                            *
- * Return value: Trend value state of the specified period and function.      *
+ *             start       - [IN] period start time in seconds since Epoch    *
+ *             end         - [IN] period end time in seconds since Epoch      *
+ *             avg         - [OUT] average of values in the period            *
+ *             sum         - [OUT] sum of values in the period                *
+ *             num         - [OUT] number of values in the period             *
+ *                                                                            *
+ * Return value: Trend value state of the specified period.                   *
+ *                                                                            *
+ * Comments: Aggregation is done by database to avoid transferring every      *
+ *           hourly record of long periods. Floating point overflow raises    *
+ *           an error in PostgreSQL and MySQL, which would also fail the      *
+ *           history syncer transaction. So the weighted sum is aggregated    *
+ *           by database only when the value range and the number of values   *
+ *           guarantee it cannot overflow, otherwise the records are summed   *
+ *           here. Integer columns are multiplied by decimal constant to      *
+ *           prevent unsigned overflow in database.                           *
+ *           Zero number of values is returned when there are no records in   *
+ *           the period.                                                      *
  *                                                                            *
  ******************************************************************************/
-static zbx_trend_state_t	trends_eval_avg(const char *table, zbx_uint64_t itemid, time_t start, time_t end,
-		double *value)
+static zbx_trend_state_t	trends_eval_weighted_sum(const char *table, zbx_uint64_t itemid, time_t start,
+		time_t end, double *avg, double *sum, double *num)
 {
-	zbx_db_result_t		result;
-	zbx_db_row_t		row;
-	char			*sql = NULL;
-	size_t			sql_alloc = 0, sql_offset = 0;
-	zbx_trend_state_t	state;
-	double			avg, num, num2, avg2;
+	zbx_db_result_t	result;
+	zbx_db_row_t	row;
+	char		*sql = NULL, *where = NULL;
+	size_t		sql_alloc = 0, sql_offset = 0, where_alloc = 0, where_offset = 0;
+	double		bound = ZBX_INFINITY;
 
 	zbx_recalc_time_period(&start, ZBX_RECALC_TIME_PERIOD_TRENDS);
 
 	if (start > end)
 		return ZBX_TREND_STATE_NODATA;
 
-	zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, "select value_avg,num from %s where itemid=" ZBX_FS_UI64,
-			table, itemid);
+	zbx_snprintf_alloc(&where, &where_alloc, &where_offset, " from %s where itemid=" ZBX_FS_UI64, table, itemid);
 
 	if (start != end)
 	{
-		zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, " and clock>=" ZBX_FS_I64 " and clock<=" ZBX_FS_I64,
-				start, end);
+		zbx_snprintf_alloc(&where, &where_alloc, &where_offset,
+				" and clock>=" ZBX_FS_I64 " and clock<=" ZBX_FS_I64, start, end);
 	}
 	else
-		zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, " and clock=" ZBX_FS_I64, start);
+		zbx_snprintf_alloc(&where, &where_alloc, &where_offset, " and clock=" ZBX_FS_I64, start);
+
+	*avg = 0;
+	*sum = 0;
+	*num = 0;
+
+	/* minimum, maximum and sum of integer column cannot overflow */
+	zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, "select min(value_avg),max(value_avg),sum(num)%s", where);
 
 	result = zbx_db_select("%s", sql);
-	zbx_free(sql);
 
-	if (NULL != (row = zbx_db_fetch(result)))
+	if (NULL != (row = zbx_db_fetch(result)) && SUCCEED != zbx_db_is_null(row[0]) &&
+			SUCCEED != zbx_db_is_null(row[1]) && SUCCEED != zbx_db_is_null(row[2]))
 	{
-		avg = atof(row[0]);
-		num = atof(row[1]);
+		*num = atof(row[2]);
+		bound = MAX(fabs(atof(row[0])), fabs(atof(row[1]))) * *num;
+	}
+
+	zbx_db_free_result(result);
+
+	if (0 == *num)
+		goto out;
+
+	sql_offset = 0;
+
+	if (DBL_MAX / 2 > bound)
+	{
+		zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, "select sum(num*1.0*value_avg)%s", where);
+
+		result = zbx_db_select("%s", sql);
+
+		if (NULL != (row = zbx_db_fetch(result)) && SUCCEED != zbx_db_is_null(row[0]))
+		{
+			*sum = atof(row[0]);
+			*avg = *sum / *num;
+		}
+		else
+			*num = 0;
+	}
+	else
+	{
+		double	avg2, num2;
+
+		zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, "select value_avg,num%s", where);
+
+		result = zbx_db_select("%s", sql);
+		*num = 0;
 
 		while (NULL != (row = zbx_db_fetch(result)))
 		{
 			avg2 = atof(row[0]);
 			num2 = atof(row[1]);
-			avg = avg / (num + num2) * num + avg2 / (num + num2) * num2;
-			num += num2;
-		}
 
-		*value = avg;
-		state = ZBX_TREND_STATE_NORMAL;
+			/* average is calculated incrementally so that it does not overflow with the sum */
+			if (0 != *num)
+				*avg = *avg / (*num + num2) * *num + avg2 / (*num + num2) * num2;
+			else
+				*avg = avg2;
+
+			*sum += avg2 * num2;
+			*num += num2;
+		}
 	}
-	else
-		state = ZBX_TREND_STATE_NODATA;
 
 	zbx_db_free_result(result);
+out:
+	zbx_free(where);
+	zbx_free(sql);
 
-	return state;
+	return ZBX_TREND_STATE_NORMAL;
 }
 
 /******************************************************************************
  *                                                                            *
- * Purpose: evaluate sum function with trends data                            *
+ * Purpose: evaluate avg function with trends data                            *
  *                                                                            *
  * Parameters: table       - [IN] trends table name                           *
  *             itemid      - [IN]                                             *
@@ -542,38 +596,50 @@ static zbx_trend_state_t	trends_eval_avg(const char *table, zbx_uint64_t itemid,
  * Return value: Trend value state of the specified period and function.      *
  *                                                                            *
  ******************************************************************************/
-static zbx_trend_state_t	trends_eval_sum(const char *table, zbx_uint64_t itemid, time_t start, time_t end,
+static zbx_trend_state_t	trends_eval_avg(const char *table, zbx_uint64_t itemid, time_t start, time_t end,
 		double *value)
 {
-	zbx_db_result_t	result;
-	zbx_db_row_t	row;
-	char		*sql = NULL;
-	size_t		sql_alloc = 0, sql_offset = 0;
-	double		sum = 0;
+	zbx_trend_state_t	state;
+	double			avg, sum, num;
 
-	zbx_recalc_time_period(&start, ZBX_RECALC_TIME_PERIOD_TRENDS);
+	if (ZBX_TREND_STATE_NORMAL != (state = trends_eval_weighted_sum(table, itemid, start, end, &avg, &sum,
+			&num)))
+	{
+		return state;
+	}
 
-	if (start > end)
+	if (0 == num)
 		return ZBX_TREND_STATE_NODATA;
 
-	zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, "select value_avg,num from %s where itemid=" ZBX_FS_UI64,
-			table, itemid);
-
-	if (start != end)
-	{
-		zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, " and clock>=" ZBX_FS_I64 " and clock<=" ZBX_FS_I64,
-				start, end);
-	}
-	else
-		zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, " and clock=" ZBX_FS_I64, start);
+	*value = avg;
 
-	result = zbx_db_select("%s", sql);
-	zbx_free(sql);
+	return ZBX_TREND_STATE_NORMAL;
+}
 
-	while (NULL != (row = zbx_db_fetch(result)))
-		sum += atof(row[0]) * atof(row[1]);
+/******************************************************************************
+ *                                                                            *
+ * Purpose: evaluate sum function with trends data                            *
+ *                                                                            *
+ * Parameters: table       - [IN] trends table name                           *
+ *             itemid      - [IN]                                             *
+ *             start       - [OUT] period start time in seconds since Epoch   *
+ *             end         - [OUT] period end time in seconds since Epoch     *
+ *             value       - [OUT] evaluation result                          *
+ *                                                                            *
+ * Return value: Trend value state of the specified period and function.      *
+ *                                                                            *
+ ******************************************************************************/
+static zbx_trend_state_t	trends_eval_sum(const char *table, zbx_uint64_t itemid, time_t start, time_t end,
+		double *value)
+{
+	zbx_trend_state_t	state;
+	double			avg, sum, num;
 
-	zbx_db_free_result(result);
+	if (ZBX_TREND_STATE_NORMAL != (state = trends_eval_weighted_sum(table, itemid, start, end, &avg, &sum,
+			&num)))
+	{
+		return state;
+	}
 
 	if (ZBX_INFINITY == sum)
 		return ZBX_TREND_STATE_OVERFLOW;
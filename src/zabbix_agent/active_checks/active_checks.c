@@ -41,6 +41,13 @@
 #	include "zbxnix.h"
 #endif
 
+/* compress collected values to reduce the size of repeated JSON tags on the wire */
+#if defined(HAVE_ZLIB)
+#	define ZBX_ACTIVE_DATA_FLAGS	(ZBX_TCP_PROTOCOL | ZBX_TCP_COMPRESS)
+#else
+#	define ZBX_ACTIVE_DATA_FLAGS	ZBX_TCP_PROTOCOL
+#endif
+
 typedef struct
 {
 	zbx_uint64_t	itemid;
@@ -75,6 +82,7 @@ typedef struct
 	int			pcount;
 	int			lastsent;
 	int			first_error;
+	int			last_error;
 }
 active_buffer_t;
 
@@ -136,6 +144,7 @@ static void	init_active_metrics(int config_buffer_size)
 		buffer.pcount = 0;
 		buffer.lastsent = (int)time(NULL);
 		buffer.first_error = 0;
+		buffer.last_error = 0;
 	}
 
 	zbx_vector_command_result_ptr_create(&command_results);
@@ -896,7 +905,7 @@ static int	refresh_active_checks(zbx_vector_addr_ptr_t *addrs, const zbx_config_
 	level = SUCCEED != last_ret ? LOG_LEVEL_DEBUG : LOG_LEVEL_WARNING;
 
 	ret = zbx_comms_exchange_with_redirect(config_source_ip, addrs, config_timeout, config_timeout, 0, level,
-			config_tls, json.buffer, NULL, NULL, &data, NULL);
+			config_tls, json.buffer, ZBX_TCP_PROTOCOL, NULL, NULL, &data, NULL);
 
 	if (SUCCEED == ret)
 	{
@@ -1002,6 +1011,15 @@ static int	format_metric_results(struct zbx_json *json, int now, int config_buff
 		goto ret;
 	}
 
+	/* while upload is failing do not retry for every new value when buffer is full - each attempt can block */
+	/* for the whole timeout and stall collection; values are kept or dropped as for a failed upload instead */
+	if (0 != buffer.first_error && config_buffer_send > now - buffer.last_error)
+	{
+		zabbix_log(LOG_LEVEL_DEBUG, "%s() now:%d last_error:%d BufferSend:%d; will not retry now",
+				__func__, now, buffer.last_error, config_buffer_send);
+		goto ret;
+	}
+
 	if (0 == buffer.count)
 		goto ret;
 
@@ -1131,6 +1149,8 @@ static void	clear_metric_results(zbx_vector_addr_ptr_t *addrs, zbx_vector_pre_pe
 			zabbix_log(LOG_LEVEL_WARNING, "Active check data upload started to fail");
 			buffer.first_error = now;
 		}
+
+		buffer.last_error = now;
 	}
 }
 
@@ -1200,7 +1220,8 @@ static int	send_buffer(zbx_vector_addr_ptr_t *addrs, zbx_vector_pre_persistent_t
 	level = 0 == buffer.first_error ? LOG_LEVEL_WARNING : LOG_LEVEL_DEBUG;
 
 	ret = zbx_comms_exchange_with_redirect(config_source_ip, addrs, MIN(buffer.count * config_timeout, 60),
-			config_timeout, 0, level, config_tls, json.buffer, connect_callback, &json, &data, NULL);
+			config_timeout, 0, level, config_tls, json.buffer, ZBX_ACTIVE_DATA_FLAGS, connect_callback,
+			&json, &data, NULL);
 
 	if (SUCCEED == ret)
 	{
@@ -1604,6 +1625,17 @@ static void	process_active_commands(zbx_vector_addr_ptr_t *addrs, const zbx_conf
 	zabbix_log(LOG_LEVEL_DEBUG, "End of %s()", __func__);
 }
 
+static int	active_metric_nextcheck_compare(const void *d1, const void *d2)
+{
+	const zbx_active_metric_t	*m1 = *(const zbx_active_metric_t * const *)d1;
+	const zbx_active_metric_t	*m2 = *(const zbx_active_metric_t * const *)d2;
+
+	ZBX_RETURN_IF_NOT_EQUAL(m1->nextcheck, m2->nextcheck);
+	ZBX_RETURN_IF_NOT_EQUAL(m1->itemid, m2->itemid);
+
+	return 0;
+}
+
 static void	process_active_checks(zbx_vector_addr_ptr_t *addrs, const zbx_config_tls_t *config_tls,
 		int config_timeout, const char *config_source_ip, const char *config_hostname, int config_buffer_send,
 		int config_buffer_size, int config_eventlog_max_lines_per_second, int config_max_lines_per_second)
@@ -1616,14 +1648,18 @@ static void	process_active_checks(zbx_vector_addr_ptr_t *addrs, const zbx_config
 
 	now = (int)time(NULL);
 
+	/* a slow check delays every check after it in the same pass - run the most overdue checks first */
+	zbx_vector_active_metrics_ptr_sort(&active_metrics, active_metric_nextcheck_compare);
+
 	for (i = 0; i < active_metrics.values_num; i++)
 	{
 		zbx_uint64_t		lastlogsize_last, lastlogsize_sent;
 		int			mtime_last, mtime_sent, ret, scheduling = FAIL;
 		zbx_active_metric_t	*metric = active_metrics.values[i];
 
+		/* metrics are sorted by nextcheck, the rest are not due yet */
 		if (metric->nextcheck > now)
-			continue;
+			break;
 
 		if (SUCCEED != zbx_get_agent_item_nextcheck(metric->itemid, metric->delay, now, &metric->nextcheck,
 				&scheduling, &error))
@@ -1793,6 +1829,7 @@ static void	update_schedule(int delta)
 	}
 
 	buffer.lastsent += delta;
+	buffer.last_error += delta;
 }
 
 #ifndef _WINDOWS
@@ -1824,7 +1861,7 @@ static void	send_heartbeat_msg(zbx_vector_addr_ptr_t *addrs, const zbx_config_tl
 	level = SUCCEED != last_ret ? LOG_LEVEL_DEBUG : LOG_LEVEL_WARNING;
 
 	ret = zbx_comms_exchange_with_redirect(config_source_ip, addrs, config_timeout, config_timeout, 0, level,
-			config_tls, json.buffer, NULL, NULL, NULL, &error);
+			config_tls, json.buffer, ZBX_TCP_PROTOCOL, NULL, NULL, NULL, &error);
 
 	if (SUCCEED == ret)
 	{
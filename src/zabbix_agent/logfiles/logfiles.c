@@ -1577,9 +1577,14 @@ static void	destroy_logfile_list(struct st_logfile **logfiles, int *logfiles_all
 static int	pick_logfile(const char *directory, const char *filename, int mtime, const zbx_regexp_t *re,
 		struct st_logfile **logfiles, int *logfiles_alloc, int *logfiles_num, char **err_msg)
 {
-	char		*logfile_candidate;
+	char		*logfile_candidate, *error = NULL;
 	zbx_stat_t	file_buf;
-	int		ret = SUCCEED;
+	int		res, ret = SUCCEED;
+
+	/* match file name before calling stat() - directories with rotated logs can contain */
+	/* lots of files not matching the pattern                                            */
+	if (ZBX_REGEXP_NO_MATCH == (res = zbx_regexp_match_precompiled2(filename, re, &error)))
+		return SUCCEED;
 
 	logfile_candidate = zbx_dsprintf(NULL, "%s%s", directory, filename);
 
@@ -1587,25 +1592,28 @@ static int	pick_logfile(const char *directory, const char *filename, int mtime,
 	{
 		if (S_ISREG(file_buf.st_mode) && mtime <= file_buf.st_mtime)
 		{
-			char	*error = NULL;
-			int	res;
-
-			if (ZBX_REGEXP_MATCH == (res = zbx_regexp_match_precompiled2(filename, re, &error)))
+			if (ZBX_REGEXP_MATCH == res)
 			{
 				add_logfile(logfiles, logfiles_alloc, logfiles_num, logfile_candidate, &file_buf);
 			}
-			else if (FAIL == res)
+			else
 			{
 				*err_msg = zbx_dsprintf(*err_msg, "error occurred while matching file name pattern"
 						" regular expression: %s", error);
-				zbx_free(error);
 				ret = FAIL;
 			}
 		}
+		else if (FAIL == res)
+		{
+			/* entries that are not selected anyway must not make the item unsupported */
+			zabbix_log(LOG_LEVEL_DEBUG, "cannot match file name pattern of skipped entry '%s': %s",
+					logfile_candidate, error);
+		}
 	}
 	else
 		zabbix_log(LOG_LEVEL_DEBUG, "cannot process entry '%s': %s", logfile_candidate, zbx_strerror(errno));
 
+	zbx_free(error);
 	zbx_free(logfile_candidate);
 
 	return ret;
@@ -17,6 +17,7 @@
 #include "zbxcfg.h"
 #include "zbxdbhigh.h"
 #include "zbxcacheconfig.h"
+#include "zbxshmem.h"
 #include "zbxcachehistory.h"
 #include "zbxdbupgrade.h"
 #include "zbxlog.h"
@@ -275,6 +276,7 @@ static zbx_uint64_t	config_history_cache_size	= 16 * ZBX_MEBIBYTE;
 static zbx_uint64_t	config_history_index_cache_size	= 4 * ZBX_MEBIBYTE;
 static zbx_uint64_t	config_trends_cache_size	= 0;
 static zbx_uint64_t	config_vmware_cache_size	= 8 * ZBX_MEBIBYTE;
+static int		config_huge_pages		= 0;
 
 static int	config_unreachable_period		= 45;
 static int	config_unreachable_delay		= 15;
@@ -1009,6 +1011,8 @@ static void	zbx_load_config(ZBX_TASK_EX *task)
 				ZBX_CONF_PARM_OPT,	10,			SEC_PER_DAY},
 		{"VMwareCacheSize",		&config_vmware_cache_size,		ZBX_CFG_TYPE_UINT64,
 				ZBX_CONF_PARM_OPT,	256 * ZBX_KIBIBYTE,	__UINT64_C(2) * ZBX_GIBIBYTE},
+		{"HugePages",			&config_huge_pages,			ZBX_CFG_TYPE_INT,
+				ZBX_CONF_PARM_OPT,	0,			1},
 		{"VMwareTimeout",		&config_vmware_timeout,			ZBX_CFG_TYPE_INT,
 				ZBX_CONF_PARM_OPT,	1,			300},
 		{"AllowRoot",			&config_allow_root,			ZBX_CFG_TYPE_INT,
@@ -1518,7 +1522,8 @@ int	MAIN_ZABBIX_ENTRY(int flags)
 							.config_timeout = zbx_config_timeout,
 							zbx_config_source_ip};
 	zbx_thread_dbsyncer_args		dbsyncer_args = {&events_cbs, config_histsyncer_frequency,
-								zbx_config_timeout, config_history_storage_pipelines};
+								zbx_config_timeout, config_history_storage_pipelines,
+								get_config_forks};
 	zbx_thread_vmware_args			vmware_args = {zbx_config_source_ip, config_vmware_frequency,
 								config_vmware_perf_frequency, config_vmware_timeout};
 	zbx_thread_snmptrapper_args		snmptrapper_args = {.config_snmptrap_file = zbx_config_snmptrap_file,
@@ -1547,6 +1552,8 @@ int	MAIN_ZABBIX_ENTRY(int flags)
 		exit(EXIT_FAILURE);
 	}
 
+	zbx_shmem_set_huge_pages(config_huge_pages);
+
 	if (SUCCEED != zbx_open_log(&log_file_cfg, config_log_level, syslog_app_name, NULL, &error))
 	{
 		zbx_error("cannot open log:%s", error);
@@ -143,6 +143,9 @@ typedef struct
 
 	/* optional sql filter to limit managed object scope (exclude templates from hosts) */
 	char				*sql_filter;
+
+	/* rows are only inserted or deleted, existing rows are never compared or updated */
+	unsigned char			insert_only;
 }
 zbx_table_data_t;
 
@@ -314,6 +317,7 @@ static zbx_table_data_t	*proxyconfig_create_table(const char *name)
 	td->rename_field = NULL;
 	td->reset_field = NULL;
 	td->sql_filter = NULL;
+	td->insert_only = 0;
 
 	zbx_vector_const_field_create(&td->fields);
 	zbx_hashset_create(&td->rows, 100, ZBX_DEFAULT_UINT64_HASH_FUNC, ZBX_DEFAULT_UINT64_COMPARE_FUNC);
@@ -326,6 +330,11 @@ static zbx_table_data_t	*proxyconfig_create_table(const char *name)
 	{
 		td->rename_field = "macro";
 	}
+	if (0 == strcmp(table->table, "item_rtdata"))
+	{
+		/* item runtime data is maintained by proxy and must be only inserted/removed */
+		td->insert_only = 1;
+	}
 	if (0 == strcmp(table->table, "hostmacro"))
 	{
 		td->rename_field = "macro";
@@ -1100,7 +1109,8 @@ static void	proxyconfig_prepare_table(zbx_table_data_t *td, const char *key_fiel
 
 	zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, "select %s", td->table->recid);
 
-	for (i = 1; i < td->fields.values_num; i++)
+	/* only record identifiers are needed to find new and removed rows */
+	for (i = 1; 0 == td->insert_only && i < td->fields.values_num; i++)
 		zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, ",%s", td->fields.values[i].field->name);
 
 	zbx_snprintf_alloc(&sql, &sql_alloc, &sql_offset, " from %s", td->table->table);
@@ -1131,6 +1141,12 @@ static void	proxyconfig_prepare_table(zbx_table_data_t *td, const char *key_fiel
 			continue;
 		}
 
+		if (0 != td->insert_only)
+		{
+			zbx_flags128_set(&row->flags, PROXYCONFIG_ROW_EXISTS);
+			continue;
+		}
+
 		if (SUCCEED != proxyconfig_compare_row(row, dbrow, &buf, &buf_alloc))
 			zbx_vector_table_row_ptr_append(&td->updates, row);
 	}
@@ -1419,9 +1435,6 @@ static int	proxyconfig_sync_hosts(zbx_vector_table_data_ptr_t *config_tables, in
 		proxyconfig_prepare_table(httpstep_field, NULL, NULL, NULL);
 	}
 
-	/* item_rtdata must be only inserted/removed and never updated */
-	zbx_vector_table_row_ptr_clear(&item_rtdata->updates);
-
 	/* interface availability changes are never updated in database, but must be marked in cache */
 	proxyconfig_check_interface_availability(interface);
 
@@ -56,6 +56,7 @@ static void	DBmass_update_trends(const ZBX_DC_TREND *trends, int trends_num,
 		trends_tmp = (ZBX_DC_TREND *)zbx_malloc(NULL, trends_num * sizeof(ZBX_DC_TREND));
 		memcpy(trends_tmp, trends, trends_num * sizeof(ZBX_DC_TREND));
 		qsort(trends_tmp, trends_num, sizeof(ZBX_DC_TREND), zbx_trend_compare);
+		zbx_merge_trends(trends_tmp, &trends_num);
 
 		while (0 < trends_num)
 			zbx_db_flush_trends(trends_tmp, &trends_num, trends_diff);
@@ -80,10 +80,44 @@ static void	diag_valuecache_add_items(struct zbx_json *json, const char *field,
 	zbx_json_close(json);
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Purpose: add value cache warm-up progress to json                          *
+ *                                                                            *
+ ******************************************************************************/
+static void	diag_valuecache_add_warmup(struct zbx_json *json, const char *field,
+		const zbx_vc_warmup_stats_t *warmup)
+{
+	const char	*state;
+
+	switch (warmup->state)
+	{
+		case ZBX_VC_WARMUP_STATE_RUNNING:
+			state = "running";
+			break;
+		case ZBX_VC_WARMUP_STATE_FINISHED:
+			state = "finished";
+			break;
+		case ZBX_VC_WARMUP_STATE_STOPPED:
+			state = "stopped";
+			break;
+		default:
+			state = "none";
+	}
+
+	zbx_json_addobject(json, field);
+	zbx_json_addstring(json, "state", state, ZBX_JSON_TYPE_STRING);
+	zbx_json_adduint64(json, "items", warmup->items_num);
+	zbx_json_adduint64(json, "processed", warmup->processed_num);
+	zbx_json_adduint64(json, "cached", warmup->cached_num);
+	zbx_json_close(json);
+}
+
 #define ZBX_DIAG_VALUECACHE_ITEMS		0x00000001
 #define ZBX_DIAG_VALUECACHE_VALUES		0x00000002
 #define ZBX_DIAG_VALUECACHE_MODE		0x00000004
 #define ZBX_DIAG_VALUECACHE_MEMORY		0x00000008
+#define ZBX_DIAG_VALUECACHE_WARMUP		0x00000010
 
 #define ZBX_DIAG_VALUECACHE_SIMPLE	(ZBX_DIAG_VALUECACHE_ITEMS | \
 					ZBX_DIAG_VALUECACHE_VALUES | \
@@ -108,11 +142,13 @@ static int	diag_add_valuecache_info(const struct zbx_json_parse *jp, struct zbx_
 	double				time1, time2, time_total = 0;
 	zbx_uint64_t			fields;
 	zbx_diag_map_t			field_map[] = {
-							{"", ZBX_DIAG_VALUECACHE_SIMPLE | ZBX_DIAG_VALUECACHE_MEMORY},
+							{"", ZBX_DIAG_VALUECACHE_SIMPLE | ZBX_DIAG_VALUECACHE_MEMORY |
+									ZBX_DIAG_VALUECACHE_WARMUP},
 							{"items", ZBX_DIAG_VALUECACHE_ITEMS},
 							{"values", ZBX_DIAG_VALUECACHE_VALUES},
 							{"mode", ZBX_DIAG_VALUECACHE_MODE},
 							{"memory", ZBX_DIAG_VALUECACHE_MEMORY},
+							{"warmup", ZBX_DIAG_VALUECACHE_WARMUP},
 							{NULL, 0}
 						};
 
@@ -152,6 +188,18 @@ static int	diag_add_valuecache_info(const struct zbx_json_parse *jp, struct zbx_
 			zbx_diag_add_mem_stats(json, "memory", &mem);
 		}
 
+		if (0 != (fields & ZBX_DIAG_VALUECACHE_WARMUP))
+		{
+			zbx_vc_warmup_stats_t	warmup;
+
+			time1 = zbx_time();
+			zbx_vc_get_warmup_stats(&warmup);
+			time2 = zbx_time();
+			time_total += time2 - time1;
+
+			diag_valuecache_add_warmup(json, "warmup", &warmup);
+		}
+
 		if (0 != tops.values_num)
 		{
 			zbx_vector_vc_item_stats_ptr_t	items;
@@ -211,6 +259,7 @@ out:
 #undef ZBX_DIAG_VALUECACHE_VALUES
 #undef ZBX_DIAG_VALUECACHE_MODE
 #undef ZBX_DIAG_VALUECACHE_MEMORY
+#undef ZBX_DIAG_VALUECACHE_WARMUP
 
 /******************************************************************************
  *                                                                            *
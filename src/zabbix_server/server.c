@@ -60,6 +60,7 @@
 #include "zbxnix.h"
 #include "zbxcomms.h"
 #include "zbxcacheconfig.h"
+#include "zbxshmem.h"
 #include "zbxdb.h"
 #include "zbxdbhigh.h"
 #include "zbxeval.h"
@@ -316,7 +317,9 @@ static zbx_uint64_t	config_history_index_cache_size	= 4 * ZBX_MEBIBYTE;
 static zbx_uint64_t	config_trends_cache_size	= 4 * ZBX_MEBIBYTE;
 static zbx_uint64_t	config_trend_func_cache_size	= 4 * ZBX_MEBIBYTE;
 static zbx_uint64_t	config_value_cache_size		= 8 * ZBX_MEBIBYTE;
+static char		*config_value_cache_snapshot_file	= NULL;
 static zbx_uint64_t	config_vmware_cache_size	= 8 * ZBX_MEBIBYTE;
+static int		config_huge_pages		= 0;
 
 static int	config_unreachable_period		= 45;
 static int	config_unreachable_delay		= 15;
@@ -726,6 +729,13 @@ static void	zbx_validate_config(ZBX_TASK_EX *task)
 		err = 1;
 	}
 
+	if (NULL != config_value_cache_snapshot_file && NULL != CONFIG_HA_NODE_NAME && '\0' != *CONFIG_HA_NODE_NAME)
+	{
+		zabbix_log(LOG_LEVEL_CRIT, "\"ValueCacheSnapshotFile\" configuration parameter cannot be used"
+				" in high availability cluster mode");
+		err = 1;
+	}
+
 	if (0 != config_trend_func_cache_size && 128 * ZBX_KIBIBYTE > config_trend_func_cache_size)
 	{
 		zabbix_log(LOG_LEVEL_CRIT, "\"TrendFunctionCacheSize\" configuration parameter must be either 0"
@@ -912,6 +922,8 @@ static void	zbx_load_config(ZBX_TASK_EX *task)
 				ZBX_CONF_PARM_OPT,	0,			__UINT64_C(2) * ZBX_GIBIBYTE},
 		{"ValueCacheSize",		&config_value_cache_size,		ZBX_CFG_TYPE_UINT64,
 				ZBX_CONF_PARM_OPT,	0,			__UINT64_C(64) * ZBX_GIBIBYTE},
+		{"ValueCacheSnapshotFile",	&config_value_cache_snapshot_file,	ZBX_CFG_TYPE_STRING,
+				ZBX_CONF_PARM_OPT,	0,			0},
 		{"CacheUpdateFrequency",	&config_confsyncer_frequency,		ZBX_CFG_TYPE_INT,
 				ZBX_CONF_PARM_OPT,	1,			SEC_PER_HOUR},
 		{"HousekeepingFrequency",	&config_housekeeping_frequency,		ZBX_CFG_TYPE_INT,
@@ -1026,6 +1038,8 @@ static void	zbx_load_config(ZBX_TASK_EX *task)
 				ZBX_CONF_PARM_OPT,	10,			SEC_PER_DAY},
 		{"VMwareCacheSize",		&config_vmware_cache_size,		ZBX_CFG_TYPE_UINT64,
 				ZBX_CONF_PARM_OPT,	256 * ZBX_KIBIBYTE,	__UINT64_C(2) * ZBX_GIBIBYTE},
+		{"HugePages",			&config_huge_pages,			ZBX_CFG_TYPE_INT,
+				ZBX_CONF_PARM_OPT,	0,			1},
 		{"VMwareTimeout",		&config_vmware_timeout,			ZBX_CFG_TYPE_INT,
 				ZBX_CONF_PARM_OPT,	1,			300},
 		{"AllowRoot",			&config_allow_root,			ZBX_CFG_TYPE_INT,
@@ -1202,6 +1216,13 @@ static void	zbx_on_exit(int ret, void *on_exit_args)
 
 		zbx_free_configuration_cache();
 
+		if (NULL != config_value_cache_snapshot_file &&
+				SUCCEED != zbx_vc_save_snapshot(config_value_cache_snapshot_file, &error))
+		{
+			zabbix_log(LOG_LEVEL_WARNING, "cannot save value cache snapshot: %s", error);
+			zbx_free(error);
+		}
+
 		/* free history value cache */
 		zbx_vc_destroy();
 
@@ -1610,7 +1631,8 @@ static int	server_startup(zbx_socket_t *listen_sock, int *ha_stat, int *ha_failo
 	zbx_thread_lld_manager_args	lld_manager_args = {get_config_forks};
 	zbx_thread_connector_manager_args	connector_manager_args = {get_config_forks};
 	zbx_thread_dbsyncer_args		dbsyncer_args = {&events_cbs, config_histsyncer_frequency,
-								zbx_config_timeout, config_history_storage_pipelines};
+								zbx_config_timeout, config_history_storage_pipelines,
+								get_config_forks};
 	zbx_thread_vmware_args			vmware_args = {zbx_config_source_ip, config_vmware_frequency,
 								config_vmware_perf_frequency, config_vmware_timeout};
 	zbx_thread_timer_args		timer_args = {get_config_forks};
@@ -1772,6 +1794,14 @@ static int	server_startup(zbx_socket_t *listen_sock, int *ha_stat, int *ha_failo
 				/* update maintenance states */
 				zbx_dc_update_maintenances(MAINTENANCE_TIMER_PENDING);
 
+				/* restore value cache before history syncers are started */
+				if (NULL != config_value_cache_snapshot_file && SUCCEED !=
+						zbx_vc_load_snapshot(config_value_cache_snapshot_file, &error))
+				{
+					zabbix_log(LOG_LEVEL_WARNING, "cannot load value cache snapshot: %s", error);
+					zbx_free(error);
+				}
+
 				zbx_db_close();
 				break;
 			case ZBX_PROCESS_TYPE_POLLER:
@@ -2135,6 +2165,8 @@ int	MAIN_ZABBIX_ENTRY(int flags)
 		exit(EXIT_FAILURE);
 	}
 
+	zbx_shmem_set_huge_pages(config_huge_pages);
+
 	if (SUCCEED != zbx_open_log(&log_file_cfg, config_log_level, syslog_app_name, NULL, &error))
 	{
 		zbx_error("cannot open log: %s", error);
@@ -0,0 +1,256 @@
+/*
+** Copyright (C) 2001-2024 Zabbix SIA
+**
+** This program is free software: you can redistribute it and/or modify it under the terms of
+** the GNU Affero General Public License as published by the Free Software Foundation, version 3.
+**
+** This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+** without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU Affero General Public License for more details.
+**
+** You should have received a copy of the GNU Affero General Public License along with this program.
+** If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include "zbxmocktest.h"
+#include "zbxmockdata.h"
+#include "zbxmockassert.h"
+#include "zbxmockutil.h"
+
+#include "zbxalgo.h"
+
+#define OPERATIONS	1
+#define RANDOM		2
+
+#define HEAP_VALUE(elem)	((int)(uintptr_t)(elem)->data)
+
+static int	heap_compare(const void *d1, const void *d2)
+{
+	const zbx_binary_heap_elem_t	*e1 = (const zbx_binary_heap_elem_t *)d1;
+	const zbx_binary_heap_elem_t	*e2 = (const zbx_binary_heap_elem_t *)d2;
+
+	ZBX_RETURN_IF_NOT_EQUAL(HEAP_VALUE(e1), HEAP_VALUE(e2));
+
+	return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Purpose: checks that every element is indexed at its position and that     *
+ *          no element is smaller than its parent                             *
+ *                                                                            *
+ ******************************************************************************/
+static void	heap_check(zbx_binary_heap_t *heap, const char *op, int step)
+{
+	int	i;
+
+	if (heap->elems_num != heap->key_index->num_data)
+	{
+		fail_msg("step %d (%s): heap has %d elements while key index has %d", step, op, heap->elems_num,
+				heap->key_index->num_data);
+	}
+
+	for (i = 0; i < heap->elems_num; i++)
+	{
+		int	index;
+
+		if (i != (index = zbx_hashmap_get(heap->key_index, heap->elems[i].key)))
+		{
+			fail_msg("step %d (%s): key " ZBX_FS_UI64 " at position %d is indexed at %d", step, op,
+					heap->elems[i].key, i, index);
+		}
+
+		if (0 != i && 0 < heap_compare(&heap->elems[(i - 1) / 2], &heap->elems[i]))
+			fail_msg("step %d (%s): element at position %d is smaller than its parent", step, op, i);
+	}
+}
+
+static void	heap_insert(zbx_binary_heap_t *heap, zbx_uint64_t key, int value)
+{
+	zbx_binary_heap_elem_t	elem = {key, (void *)(uintptr_t)value};
+
+	zbx_binary_heap_insert(heap, &elem);
+}
+
+static void	heap_update(zbx_binary_heap_t *heap, zbx_uint64_t key, int value)
+{
+	zbx_binary_heap_elem_t	elem = {key, (void *)(uintptr_t)value};
+
+	zbx_binary_heap_update_direct(heap, &elem);
+}
+
+static void	heap_check_order(zbx_binary_heap_t *heap, int step)
+{
+	zbx_mock_handle_t	hkeys, hkey;
+	zbx_mock_error_t	err;
+	zbx_uint64_t		key;
+
+	hkeys = zbx_mock_get_parameter_handle("out.keys");
+
+	while (ZBX_MOCK_END_OF_VECTOR != (err = zbx_mock_vector_element(hkeys, &hkey)))
+	{
+		if (ZBX_MOCK_SUCCESS != err || ZBX_MOCK_SUCCESS != (err = zbx_mock_uint64(hkey, &key)))
+			fail_msg("Cannot read expected key: %s", zbx_mock_error_string(err));
+
+		if (SUCCEED == zbx_binary_heap_empty(heap))
+			fail_msg("heap is empty while expecting key " ZBX_FS_UI64, key);
+
+		zbx_mock_assert_uint64_eq("minimum key", key, zbx_binary_heap_find_min(heap)->key);
+		zbx_binary_heap_remove_min(heap);
+		heap_check(heap, "remove_min", ++step);
+	}
+
+	zbx_mock_assert_int_eq("remaining elements", 0, heap->elems_num);
+}
+
+static void	test_heap_operations(void)
+{
+	zbx_binary_heap_t	heap;
+	zbx_mock_handle_t	hops, hop;
+	zbx_mock_error_t	err;
+	int			step = 0;
+
+	zbx_binary_heap_create(&heap, heap_compare, ZBX_BINARY_HEAP_OPTION_DIRECT);
+
+	hops = zbx_mock_get_parameter_handle("in.operations");
+
+	while (ZBX_MOCK_END_OF_VECTOR != (err = zbx_mock_vector_element(hops, &hop)))
+	{
+		const char	*op;
+
+		if (ZBX_MOCK_SUCCESS != err)
+			fail_msg("Cannot read operation: %s", zbx_mock_error_string(err));
+
+		op = zbx_mock_get_object_member_string(hop, "op");
+
+		if (0 == strcmp(op, "insert"))
+		{
+			heap_insert(&heap, zbx_mock_get_object_member_uint64(hop, "key"),
+					zbx_mock_get_object_member_int(hop, "value"));
+		}
+		else if (0 == strcmp(op, "update"))
+		{
+			heap_update(&heap, zbx_mock_get_object_member_uint64(hop, "key"),
+					zbx_mock_get_object_member_int(hop, "value"));
+		}
+		else if (0 == strcmp(op, "remove"))
+		{
+			zbx_binary_heap_remove_direct(&heap, zbx_mock_get_object_member_uint64(hop, "key"));
+		}
+		else if (0 == strcmp(op, "remove_min"))
+		{
+			zbx_binary_heap_remove_min(&heap);
+		}
+		else
+			fail_msg("unknown heap operation: %s", op);
+
+		heap_check(&heap, op, ++step);
+	}
+
+	heap_check_order(&heap, step);
+
+	zbx_binary_heap_destroy(&heap);
+}
+
+static zbx_uint64_t	random_next(zbx_uint64_t *seed)
+{
+	*seed = *seed * __UINT64_C(6364136223846793005) + __UINT64_C(1442695040888963407);
+
+	return *seed >> 33;
+}
+
+static void	test_heap_random(void)
+{
+	zbx_binary_heap_t	heap;
+	zbx_uint64_t		seed, keys_num, key;
+	int			i, iterations, *values;
+	const char		*op;
+
+	seed = zbx_mock_get_parameter_uint64("in.seed");
+	keys_num = zbx_mock_get_parameter_uint64("in.keys");
+	iterations = (int)zbx_mock_get_parameter_uint64("in.iterations");
+
+	/* values of keys in heap, -1 for keys not in heap */
+	values = (int *)zbx_malloc(NULL, sizeof(int) * keys_num);
+	memset(values, -1, sizeof(int) * keys_num);
+
+	zbx_binary_heap_create(&heap, heap_compare, ZBX_BINARY_HEAP_OPTION_DIRECT);
+
+	for (i = 0; i < iterations; i++)
+	{
+		int	value = (int)(random_next(&seed) % 1000);
+
+		key = random_next(&seed) % keys_num;
+
+		if (0 == random_next(&seed) % 8 && SUCCEED != zbx_binary_heap_empty(&heap))
+		{
+			zbx_binary_heap_elem_t	*min = zbx_binary_heap_find_min(&heap);
+			zbx_uint64_t		j;
+
+			for (j = 0; j < keys_num; j++)
+			{
+				if (-1 != values[j] && values[j] < HEAP_VALUE(min))
+				{
+					fail_msg("step %d: minimum value %d is larger than %d", i, HEAP_VALUE(min),
+							values[j]);
+				}
+			}
+
+			values[min->key] = -1;
+			zbx_binary_heap_remove_min(&heap);
+			op = "remove_min";
+		}
+		else if (-1 == values[key])
+		{
+			heap_insert(&heap, key, value);
+			values[key] = value;
+			op = "insert";
+		}
+		else if (0 == random_next(&seed) % 2)
+		{
+			heap_update(&heap, key, value);
+			values[key] = value;
+			op = "update";
+		}
+		else
+		{
+			zbx_binary_heap_remove_direct(&heap, key);
+			values[key] = -1;
+			op = "remove";
+		}
+
+		heap_check(&heap, op, i);
+	}
+
+	zbx_binary_heap_destroy(&heap);
+	zbx_free(values);
+}
+
+static int	get_type(const char *str)
+{
+	if (0 == strcmp(str, "OPERATIONS"))
+		return OPERATIONS;
+
+	if (0 == strcmp(str, "RANDOM"))
+		return RANDOM;
+
+	fail_msg("unknown cmocka step type: %s", str);
+	return FAIL;
+}
+
+void	zbx_mock_test_entry(void **state)
+{
+	ZBX_UNUSED(state);
+
+	switch (get_type(zbx_mock_get_parameter_string("in.type")))
+	{
+		case OPERATIONS:
+			test_heap_operations();
+			break;
+		case RANDOM:
+			test_heap_random();
+			break;
+		default:
+			fail_msg("unknown cmocka step type: %s", zbx_mock_get_parameter_string("in.type"));
+	}
+}
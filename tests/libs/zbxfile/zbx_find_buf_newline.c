@@ -0,0 +1,104 @@
+/*
+** Copyright (C) 2001-2024 Zabbix SIA
+**
+** This program is free software: you can redistribute it and/or modify it under the terms of
+** the GNU Affero General Public License as published by the Free Software Foundation, version 3.
+**
+** This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+** without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU Affero General Public License for more details.
+**
+** You should have received a copy of the GNU Affero General Public License along with this program.
+** If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include "zbxfile.h"
+
+#include "zbxcommon.h"
+
+#include "zbxmocktest.h"
+#include "zbxmockdata.h"
+#include "zbxmockassert.h"
+#include "zbxmockutil.h"
+
+/* the buffer is placed at every offset within a 64-bit word to test unaligned starts */
+#define ZBX_TEST_WORD_SIZE	8
+
+static void	assert_data_eq(const char *name, size_t offset, int line_num, const char *expected,
+		size_t expected_len, const char *returned, size_t returned_len)
+{
+	if (expected_len != returned_len || 0 != memcmp(expected, returned, expected_len))
+	{
+		fail_msg("buffer offset %d, %s %d: expected %d bytes \"%.*s\" while returned %d bytes \"%.*s\"",
+				(int)offset, name, line_num, (int)expected_len, (int)expected_len, expected,
+				(int)returned_len, (int)returned_len, returned);
+	}
+}
+
+static void	test_find_buf_newline(const char *data, size_t data_len, size_t offset, const char *encoding)
+{
+	const char		*cr, *lf, *expected;
+	char			*buf, *p, *p_end, *p_next, *p_line;
+	size_t			szbyte, expected_len;
+	int			line_num = 0;
+	zbx_mock_handle_t	hlines, hline;
+	zbx_mock_error_t	err;
+
+	zbx_find_cr_lf_szbyte(encoding, &cr, &lf, &szbyte);
+
+	/* allocate exactly the tested size, so that reads past the buffer end are caught by memory checkers */
+	buf = (char *)zbx_malloc(NULL, offset + data_len);
+	p = buf + offset;
+	memcpy(p, data, data_len);
+	p_end = p + data_len;
+
+	hlines = zbx_mock_get_parameter_handle("out.lines");
+
+	while (NULL != (p_line = zbx_find_buf_newline(p, &p_next, p_end, cr, lf, szbyte)))
+	{
+		if (ZBX_MOCK_SUCCESS != (err = zbx_mock_vector_element(hlines, &hline)))
+			fail_msg("buffer offset %d: unexpected line %d found", (int)offset, line_num);
+
+		if (ZBX_MOCK_SUCCESS != (err = zbx_mock_binary(hline, &expected, &expected_len)))
+			fail_msg("Cannot read line %d: %s", line_num, zbx_mock_error_string(err));
+
+		assert_data_eq("line", offset, line_num, expected, expected_len, p, (size_t)(p_line - p));
+
+		if (p_next <= p_line || p_next > p_end)
+			fail_msg("buffer offset %d, line %d: invalid next line position", (int)offset, line_num);
+
+		p = p_next;
+		line_num++;
+	}
+
+	if (ZBX_MOCK_END_OF_VECTOR != zbx_mock_vector_element(hlines, &hline))
+		fail_msg("buffer offset %d: expected more than %d lines", (int)offset, line_num);
+
+	/* the remaining data without newline, with NUL characters replaced */
+	if (ZBX_MOCK_SUCCESS != (err = zbx_mock_binary(zbx_mock_get_parameter_handle("out.rest"), &expected,
+			&expected_len)))
+	{
+		fail_msg("Cannot read rest: %s", zbx_mock_error_string(err));
+	}
+
+	assert_data_eq("rest after line", offset, line_num, expected, expected_len, p, (size_t)(p_end - p));
+
+	zbx_free(buf);
+}
+
+void	zbx_mock_test_entry(void **state)
+{
+	const char		*data, *encoding;
+	size_t			data_len, offset;
+	zbx_mock_error_t	err;
+
+	ZBX_UNUSED(state);
+
+	encoding = zbx_mock_get_parameter_string("in.encoding");
+
+	if (ZBX_MOCK_SUCCESS != (err = zbx_mock_binary(zbx_mock_get_parameter_handle("in.data"), &data, &data_len)))
+		fail_msg("Cannot read data: %s", zbx_mock_error_string(err));
+
+	for (offset = 0; offset < ZBX_TEST_WORD_SIZE; offset++)
+		test_find_buf_newline(data, data_len, offset, encoding);
+}
@@ -0,0 +1,151 @@
+/*
+** Copyright (C) 2001-2024 Zabbix SIA
+**
+** This program is free software: you can redistribute it and/or modify it under the terms of
+** the GNU Affero General Public License as published by the Free Software Foundation, version 3.
+**
+** This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+** without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU Affero General Public License for more details.
+**
+** You should have received a copy of the GNU Affero General Public License along with this program.
+** If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include "zbxmocktest.h"
+#include "zbxmockdata.h"
+#include "zbxmockassert.h"
+#include "zbxmockutil.h"
+
+#include "zbxcommon.h"
+#include "zbxtrends.h"
+#include "zbxdbhigh.h"
+
+#define TEST_ROW_COLUMNS_MAX	4
+
+struct zbx_db_result
+{
+	zbx_mock_handle_t	rows;
+	char			*row[TEST_ROW_COLUMNS_MAX];
+};
+
+static zbx_mock_handle_t	hqueries;
+static struct zbx_db_result	test_result;
+
+int	__wrap_zbx_db_is_null(const char *field);
+zbx_db_row_t	__wrap_zbx_db_fetch(zbx_db_result_t result);
+zbx_db_result_t	__wrap_zbx_db_select(const char *fmt, ...);
+void	__wrap_zbx_db_free_result(zbx_db_result_t result);
+void	__wrap_zbx_recalc_time_period(time_t *tm_start, int table_group);
+
+int	__wrap_zbx_db_is_null(const char *field)
+{
+	return NULL == field ? SUCCEED : FAIL;
+}
+
+/* rows are read from the next test query, "NULL" fields are returned as SQL NULL */
+zbx_db_row_t	__wrap_zbx_db_fetch(zbx_db_result_t result)
+{
+	zbx_mock_handle_t	hrow, hfield;
+	zbx_mock_error_t	err;
+	int			column = 0;
+
+	if (NULL == result || ZBX_MOCK_END_OF_VECTOR == zbx_mock_vector_element(result->rows, &hrow))
+		return NULL;
+
+	while (ZBX_MOCK_END_OF_VECTOR != (err = zbx_mock_vector_element(hrow, &hfield)))
+	{
+		const char	*field;
+
+		if (TEST_ROW_COLUMNS_MAX <= column)
+			fail_msg("too many columns in row");
+
+		if (ZBX_MOCK_SUCCESS != err || ZBX_MOCK_SUCCESS != (err = zbx_mock_string(hfield, &field)))
+			fail_msg("Cannot read row field: %s", zbx_mock_error_string(err));
+
+		result->row[column++] = 0 == strcmp(field, "NULL") ? NULL : (char *)field;
+	}
+
+	while (TEST_ROW_COLUMNS_MAX > column)
+		result->row[column++] = NULL;
+
+	return result->row;
+}
+
+zbx_db_result_t	__wrap_zbx_db_select(const char *fmt, ...)
+{
+	va_list			args;
+	char			*sql;
+	const char		*sql_exp;
+	zbx_mock_handle_t	hquery;
+
+	va_start(args, fmt);
+	sql = zbx_dvsprintf(NULL, fmt, args);
+	va_end(args);
+
+	printf("\tSQL: %s\n", sql);
+
+	if (ZBX_MOCK_SUCCESS != zbx_mock_vector_element(hqueries, &hquery))
+		fail_msg("unexpected query: %s", sql);
+
+	/* the expected query is a prefix of the executed query, the condition part is not compared */
+	sql_exp = zbx_mock_get_object_member_string(hquery, "sql");
+
+	if (0 != strncmp(sql, sql_exp, strlen(sql_exp)))
+		fail_msg("expected query \"%s\" while executed \"%s\"", sql_exp, sql);
+
+	zbx_free(sql);
+
+	test_result.rows = zbx_mock_get_object_member_handle(hquery, "rows");
+
+	return &test_result;
+}
+
+void	__wrap_zbx_db_free_result(zbx_db_result_t result)
+{
+	ZBX_UNUSED(result);
+}
+
+void	__wrap_zbx_recalc_time_period(time_t *tm_start, int table_group)
+{
+	ZBX_UNUSED(tm_start);
+	ZBX_UNUSED(table_group);
+}
+
+void	zbx_mock_test_entry(void **state)
+{
+	const char		*function;
+	char			*error = NULL;
+	double			value;
+	time_t			start, end;
+	int			ret, expected_ret;
+	zbx_mock_handle_t	hquery;
+
+	ZBX_UNUSED(state);
+
+	hqueries = zbx_mock_get_parameter_handle("in.queries");
+
+	function = zbx_mock_get_parameter_string("in.function");
+	start = (time_t)zbx_mock_get_parameter_uint64("in.start");
+	end = (time_t)zbx_mock_get_parameter_uint64("in.end");
+
+	if (0 == strcmp(function, "avg"))
+		ret = zbx_trends_eval_avg("trends", 1, start, end, &value, &error);
+	else if (0 == strcmp(function, "sum"))
+		ret = zbx_trends_eval_sum("trends", 1, start, end, &value, &error);
+	else
+		fail_msg("unknown trend function: %s", function);
+
+	expected_ret = zbx_mock_str_to_return_code(zbx_mock_get_parameter_string("out.return"));
+	zbx_mock_assert_result_eq("return value", expected_ret, ret);
+
+	if (SUCCEED == ret)
+		zbx_mock_assert_double_eq("value", zbx_mock_get_parameter_float("out.value"), value);
+	else
+		zbx_mock_assert_str_eq("error", zbx_mock_get_parameter_string("out.error"), error);
+
+	if (ZBX_MOCK_END_OF_VECTOR != zbx_mock_vector_element(hqueries, &hquery))
+		fail_msg("expected more queries");
+
+	zbx_free(error);
+}